@@ -0,0 +1,141 @@
+#ifndef S21_ALIGNED_ALLOCATOR_H
+#define S21_ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "s21_numa.h"
+
+// Выравнивание строк матрицы (размер строки кэша)
+constexpr std::size_t kS21Alignment = 64;
+
+// Политика страниц для хранилища матрицы
+enum class S21PagePolicy {
+  kDefault,          // обычные выровненные выделения на каждую строку
+  kTransparentHuge,  // общий буфер, помеченный madvise(MADV_HUGEPAGE)
+  kHugeTlb           // общий буфер из hugetlbfs (MAP_HUGETLB)
+};
+
+// Область памяти из крупных отображений, из которой строки одной матрицы
+// нарезаются подряд с выравниванием kS21Alignment. Для каждого
+// отображения считается объём занятых строк: когда все его строки
+// освобождены, отображение используется заново (текущее) или уходит в
+// общий кэш процесса, откуда его берут следующие области того же
+// размера, так что копии матриц не отображают память заново. Если
+// huge-страницы недоступны, используется следующий по списку вариант:
+// hugetlbfs -> прозрачные huge-страницы -> обычные страницы.
+// При политике NUMA kBind или kInterleave новое отображение получает её
+// через mbind, так что она действует на все строки области, включая
+// добавленные и удлинённые позже. Страницы отображений из кэша уже
+// размещены, поэтому кэш выдаёт их только областям с той же политикой
+// (и тем же узлом для kBind); при kFirstTouch страницы остаются на узлах
+// потоков, первыми записавших в них.
+class S21PageArena {
+ public:
+  explicit S21PageArena(S21PagePolicy policy,
+                        S21MemoryPolicy memory = S21MemoryPolicy::kFirstTouch,
+                        int node = 0);
+  S21PageArena(const S21PageArena&) = delete;
+  S21PageArena& operator=(const S21PageArena&) = delete;
+  ~S21PageArena();
+
+  // Место под count участков по bytes байт
+  void Reserve(std::size_t count, std::size_t bytes);
+  void* Allocate(std::size_t bytes);
+  void Deallocate(void* pointer, std::size_t bytes) noexcept;
+  S21PagePolicy Policy() const noexcept;
+  // Получена ли хотя бы часть памяти huge-страницами (hugetlbfs или
+  // MADV_HUGEPAGE при включённых в системе прозрачных huge-страницах)
+  bool HugePages() const noexcept;
+  // Суммарный размер отображений области
+  std::size_t MappedBytes();
+
+ private:
+  struct Chunk {
+    char* base;
+    std::size_t size;
+    std::size_t used;  // байт в ещё не освобождённых строках
+    S21PagePolicy pages;  // вид страниц, с которым создано отображение
+    bool huge;
+    S21MemoryPolicy memory;
+    int node;
+  };
+  struct Cache;
+
+  static std::size_t blockSize(std::size_t bytes) noexcept;
+  static Cache& cache();
+  bool takeCached(std::size_t size, S21PagePolicy pages, Chunk& chunk) const;
+  static void release(const Chunk& chunk) noexcept;
+  void mapChunk(std::size_t bytes);
+  void mapPages(Chunk& chunk) const;
+
+  std::mutex mutex_;
+  std::vector<Chunk> chunks_;
+  char* cursor_;
+  char* end_;
+  S21PagePolicy policy_;
+  S21MemoryPolicy memory_;
+  int node_;
+  bool huge_;
+};
+
+// Аллокатор строк: без области - выровненный operator new,
+// с областью - нарезка из неё. Копии контейнеров получают аллокатор
+// без области, чтобы не продлевать жизнь чужой области.
+template <class T>
+class S21AlignedAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  S21AlignedAllocator() noexcept = default;
+  explicit S21AlignedAllocator(std::shared_ptr<S21PageArena> arena) noexcept
+      : arena_(std::move(arena)) {}
+  template <class U>
+  S21AlignedAllocator(const S21AlignedAllocator<U>& other) noexcept
+      : arena_(other.Arena()) {}
+
+  T* allocate(std::size_t count) {
+    const std::size_t bytes = count * sizeof(T);
+    if (arena_) return static_cast<T*>(arena_->Allocate(bytes));
+    return static_cast<T*>(
+        ::operator new(bytes, std::align_val_t(kS21Alignment)));
+  }
+
+  void deallocate(T* pointer, std::size_t count) noexcept {
+    if (arena_) {
+      arena_->Deallocate(pointer, count * sizeof(T));
+    } else {
+      ::operator delete(pointer, std::align_val_t(kS21Alignment));
+    }
+  }
+
+  S21AlignedAllocator select_on_container_copy_construction() const {
+    return S21AlignedAllocator();
+  }
+
+  const std::shared_ptr<S21PageArena>& Arena() const noexcept {
+    return arena_;
+  }
+
+  template <class U>
+  bool operator==(const S21AlignedAllocator<U>& other) const noexcept {
+    return arena_ == other.Arena();
+  }
+
+  template <class U>
+  bool operator!=(const S21AlignedAllocator<U>& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  std::shared_ptr<S21PageArena> arena_;
+};
+
+#endif
@@ -1,30 +1,84 @@
 #include "s21_matrix.h"
 
+#include <cmath>
+#include <limits>
+
+#include "s21_thread_pool.h"
+
 // Методы
 
 // Конструктор по умолчанию
-S21Matrix::S21Matrix() noexcept : rows_(0), cols_(0), matrix_() {}
+S21Matrix::S21Matrix() noexcept
+    : rows_(0),
+      cols_(0),
+      matrix_(),
+      transposed_(false),
+      reserved_cols_(0),
+      memory_policy_(S21MemoryPolicy::kFirstTouch),
+      node_(0) {}
 
 // Конструктор по измерениям
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+S21Matrix::S21Matrix(int rows, int cols)
+    : rows_(rows),
+      cols_(cols),
+      transposed_(false),
+      reserved_cols_(0),
+      memory_policy_(S21MemoryPolicy::kFirstTouch),
+      node_(0) {
+  if (rows_ < 1 || cols_ < 1) {
+    throw std::invalid_argument("Matrix dimensions must be greater than 0.");
+  }
+  allocate(S21MemoryPolicy::kFirstTouch, 0, S21PagePolicy::kDefault);
+}
+
+// Конструктор с явной политикой размещения по узлам NUMA и политикой
+// страниц
+S21Matrix::S21Matrix(int rows, int cols, S21MemoryPolicy policy, int node,
+                     S21PagePolicy pages)
+    : rows_(rows),
+      cols_(cols),
+      transposed_(false),
+      reserved_cols_(0),
+      memory_policy_(policy),
+      node_(node) {
   if (rows_ < 1 || cols_ < 1) {
     throw std::invalid_argument("Matrix dimensions must be greater than 0.");
   }
-  matrix_ =
-      std::vector<std::vector<double>>(rows_, std::vector<double>(cols, 0.0));
+  if (policy == S21MemoryPolicy::kBind) S21Numa::NodeCpus(node);
+  allocate(policy, node, pages);
 }
 
+// Конструктор с политикой страниц (huge-страницы для больших матриц)
+S21Matrix::S21Matrix(int rows, int cols, S21PagePolicy pages)
+    : S21Matrix(rows, cols, S21MemoryPolicy::kFirstTouch, 0, pages) {}
+
 // Коструктор копирования
 S21Matrix::S21Matrix(const S21Matrix& other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {}
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(other.matrix_ ? copyStorage(*other.matrix_, other.memory_policy_,
+                                          other.node_)
+                            : nullptr),
+      transposed_(other.transposed_),
+      reserved_cols_(0),
+      memory_policy_(other.memory_policy_),
+      node_(other.node_) {}
 
 // Конструктор переноса
 S21Matrix::S21Matrix(S21Matrix&& other) noexcept
     : rows_(other.rows_),
       cols_(other.cols_),
-      matrix_(std::move(other.matrix_)) {
+      matrix_(std::move(other.matrix_)),
+      transposed_(other.transposed_),
+      reserved_cols_(other.reserved_cols_),
+      memory_policy_(other.memory_policy_),
+      node_(other.node_) {
   other.rows_ = 0;
   other.cols_ = 0;
+  other.transposed_ = false;
+  other.reserved_cols_ = 0;
+  other.memory_policy_ = S21MemoryPolicy::kFirstTouch;
+  other.node_ = 0;
 }
 
 // Деструктор
@@ -43,39 +97,62 @@ double S21Matrix::getElement(int row, int col) const {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
     throw std::out_of_range("Matrix indices out of range.");
   }
-  return matrix_[row][col];
+  return transposed_ ? (*matrix_)[col][row] : (*matrix_)[row][col];
+}
+
+// Хранится ли матрица в транспонированном виде
+bool S21Matrix::IsTransposed() const noexcept { return transposed_; }
+
+// Политика страниц хранилища
+S21PagePolicy S21Matrix::PagePolicy() const noexcept {
+  if (!matrix_ || matrix_->empty()) return S21PagePolicy::kDefault;
+  const S21PageArena* arena = matrix_->front().get_allocator().Arena().get();
+  return arena ? arena->Policy() : S21PagePolicy::kDefault;
+}
+
+// Получены ли страницы хранилища как huge-страницы (при недоступности
+// hugetlbfs и THP политика сохраняется, но страницы обычные)
+bool S21Matrix::HugePages() const noexcept {
+  if (!matrix_ || matrix_->empty()) return false;
+  const S21PageArena* arena = matrix_->front().get_allocator().Arena().get();
+  return arena && arena->HugePages();
 }
 
 // Мутаторы
 
 // Для строк
+// Строки добавляются и удаляются на месте, остальные строки не копируются.
+// У пустой матрицы нет столбцов, и изменить число строк нельзя.
 void S21Matrix::SetRows(int rows) {
-  if (rows <= 0) {
+  if (rows <= 0 || !matrix_ || cols_ == 0) {
     throw std::invalid_argument("Matrix dimensions must be greater than 0.");
   }
   if (rows != rows_) {
-    S21Matrix tmp(rows, cols_);
-    for (int i = 0; i < std::min(rows_, rows); ++i) {
-      std::copy(matrix_[i].begin(), matrix_[i].begin() + cols_,
-                tmp.matrix_[i].begin());
+    Materialize();
+    if (rows < rows_) {
+      matrix_->resize(rows);
+    } else {
+      for (int i = rows_; i < rows; ++i) matrix_->push_back(newRow());
     }
-    matrix_ = std::move(tmp.matrix_);
     rows_ = rows;
   }
 }
 
 // Для столбцов
+// Строки меняют длину на месте, при нехватке ёмкости она растёт вдвое.
+// У пустой матрицы нет строк, и изменить число столбцов нельзя.
 void S21Matrix::SetCols(int cols) {
-  if (cols < 0) {
+  if (cols <= 0 || !matrix_ || rows_ == 0) {
     throw std::invalid_argument("Matrix dimensions must be greater than 0.");
   }
   if (cols != cols_) {
-    S21Matrix tmp(rows_, cols);
-    for (int i = 0; i < rows_; ++i) {
-      std::copy(matrix_[i].begin(), matrix_[i].begin() + std::min(cols_, cols),
-                tmp.matrix_[i].begin());
+    Materialize();
+    for (auto& row : *matrix_) {
+      if (static_cast<size_t>(cols) > row.capacity()) {
+        row.reserve(std::max<size_t>(cols, row.capacity() * 2));
+      }
+      row.resize(cols, 0.0);
     }
-    matrix_ = std::move(tmp.matrix_);
     cols_ = cols;
   }
 }
@@ -91,28 +168,45 @@ void S21Matrix::SetElement(int row, int col, double value) {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
     throw std::out_of_range("Matrix indices out of range.");
   }
-  matrix_[row][col] = value;
+  detach();
+  (transposed_ ? (*matrix_)[col][row] : (*matrix_)[row][col]) = value;
+}
+
+// Резервирование места под rows x cols без изменения размеров
+void S21Matrix::Reserve(int rows, int cols) {
+  if (rows < 1 || cols < 1) {
+    throw std::invalid_argument("Matrix dimensions must be greater than 0.");
+  }
+  if (!matrix_) matrix_ = std::make_shared<Storage>();
+  Materialize();
+  matrix_->reserve(rows);
+  for (auto& row : *matrix_) row.reserve(cols);
+  reserved_cols_ = std::max(reserved_cols_, cols);
+}
+
+// Добавление строки в конец матрицы за амортизированное O(cols)
+// Пустая матрица принимает число столбцов по первой строке
+void S21Matrix::AppendRow(const double* values, int count) {
+  if (count < 1 || (rows_ > 0 && count != cols_)) {
+    throw std::invalid_argument("Row length does not match matrix columns.");
+  }
+  if (!matrix_) matrix_ = std::make_shared<Storage>();
+  Materialize();
+  if (rows_ == 0) cols_ = count;
+  matrix_->push_back(newRow());
+  std::copy(values, values + count, matrix_->back().begin());
+  ++rows_;
+}
+
+void S21Matrix::AppendRow(const std::vector<double>& row) {
+  AppendRow(row.data(), static_cast<int>(row.size()));
 }
 
 // Операции
 
 // Проверка равенства матриц
 bool S21Matrix::EqMatrix(const S21Matrix& other) const {
-  bool status = true;
-  if (rows_ != other.rows_ || cols_ != other.cols_)
-    status = false;
-  else {
-    for (int i = 0; i < rows_; ++i) {
-      if (status == false) break;
-      for (int j = 0; j < cols_; ++j) {
-        if (std::abs(matrix_[i][j] - other.matrix_[i][j]) > 1e-7) {
-          status = false;
-          break;
-        }
-      }
-    }
-  }
-  return status;
+  return EqMatrix(other, 1e-7, 0.0);
 }
 
 // Прибавление к матрице
@@ -120,9 +214,19 @@ void S21Matrix::SumMatrix(const S21Matrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Matrices dimensions are not equal.");
   }
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] += other.matrix_[i][j];
+  if (!matrix_) return;
+  detach();
+  Storage& a = *matrix_;
+  const Storage& b = *other.matrix_;
+  const int rows = transposed_ ? cols_ : rows_;
+  const int cols = transposed_ ? rows_ : cols_;
+  if (transposed_ == other.transposed_) {
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) a[i][j] += b[i][j];
+    }
+  } else {
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) a[i][j] += b[j][i];
     }
   }
 }
@@ -132,85 +236,219 @@ void S21Matrix::SubMatrix(const S21Matrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Matrices dimensions are not equal.");
   }
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] -= other.matrix_[i][j];
+  if (!matrix_) return;
+  detach();
+  Storage& a = *matrix_;
+  const Storage& b = *other.matrix_;
+  const int rows = transposed_ ? cols_ : rows_;
+  const int cols = transposed_ ? rows_ : cols_;
+  if (transposed_ == other.transposed_) {
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) a[i][j] -= b[i][j];
+    }
+  } else {
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) a[i][j] -= b[j][i];
     }
   }
 }
 
 // Умножение на число
 void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] *= num;
-    }
+  if (!matrix_) return;
+  detach();
+  for (auto& row : *matrix_) {
+    for (auto& value : row) value *= num;
   }
 }
 
 // Умножение на матрицу
+// Порядок обхода выбирается по расположению операндов, а произведение
+// двух транспонированных матриц считается как (B * A)^T без копирования.
 void S21Matrix::MulMatrix(const S21Matrix& other) {
   if (cols_ != other.rows_) {
     throw std::invalid_argument("Matrix dimensions are not comparable.");
   }
-  S21Matrix result(rows_, other.cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      for (int k = 0; k < cols_; ++k) {
-        result.matrix_[i][j] += matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
+  if (transposed_ && other.transposed_) {
+    S21Matrix result(other.cols_, rows_);
+    multiplyKernel(*other.matrix_, false, *matrix_, false, *result.matrix_,
+                   other.cols_, cols_, rows_);
+    *this = result.Transpose();
+  } else {
+    S21Matrix result(rows_, other.cols_);
+    multiplyKernel(*matrix_, transposed_, *other.matrix_, other.transposed_,
+                   *result.matrix_, rows_, cols_, other.cols_);
+    *this = std::move(result);
   }
-  *this = std::move(result);
 }
 
 // Создание транспонированной матрицы
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix result(cols_, rows_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      result.matrix_[j][i] = matrix_[i][j];
-    }
-  }
+// Результат разделяет хранилище с исходной матрицей и отличается только
+// флагом расположения, копирование откладывается до первой записи.
+// Ссылки на элементы, полученные от operator() до вызова, становятся
+// недействительными: запись по ним изменила бы и результат.
+S21Matrix S21Matrix::Transpose() const {
+  S21Matrix result = share();
+  std::swap(result.rows_, result.cols_);
+  result.transposed_ = !transposed_;
   return result;
 }
 
+// Явное построение собственной копии данных в обычном (построчном) виде
+void S21Matrix::Materialize() {
+  if (!transposed_) {
+    detach();
+    return;
+  }
+  const Storage& source = *matrix_;
+  S21Matrix result(rows_, cols_, memory_policy_, node_, PagePolicy());
+  Storage& target = *result.matrix_;
+  parallelFor(0, rows_, cols_, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      for (int j = 0; j < cols_; ++j) target[i][j] = source[j][i];
+    }
+  });
+  matrix_ = std::move(result.matrix_);
+  transposed_ = false;
+}
+
 // Вычисление матрицы алгебраических дополнений
-S21Matrix S21Matrix::CalcComplements() {
+// Строится по LU-разложению: для невырожденной матрицы adj(A) = det(A) * A^-1,
+// для матрицы ранга n - 1 присоединённая матрица имеет ранг 1 и собирается
+// из нуль-векторов U и L^T, при меньшем ранге все дополнения равны нулю.
+S21Matrix S21Matrix::CalcComplements() const {
   if (rows_ != cols_) {
     throw std::invalid_argument(
         "Matrix must be square to calculate complements.");
   }
-  S21Matrix result(rows_, cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      S21Matrix submatrix = minor(i, j);
-      double sub_det = determinantRecursive(submatrix);
-      result.matrix_[i][j] = ((i + j) % 2 == 0 ? 1 : -1) * sub_det;
+  const int n = rows_;
+  LUDecomposition lu = decomposeLU();
+  S21Matrix result(n, n);
+  if (lu.numerical_rank == n) {
+    const double det = luDeterminant(lu, n);
+    Storage& out = *result.matrix_;
+    // Столбец c обратной матрицы даёт строку c матрицы дополнений
+    parallelFor(0, n, static_cast<long long>(n) * n, [&](int from, int to) {
+      std::vector<double> x(n);
+      for (int c = from; c < to; ++c) {
+        luSolveColumn(lu, c, x);
+        for (int i = 0; i < n; ++i) out[c][i] = det * x[i];
+      }
+    });
+  } else if (lu.numerical_rank == n - 1) {
+    // adj(U) = det(U1) * [-U1^-1 * u; 1] * e_n^T
+    std::vector<double> x(n, 0.0);
+    x[n - 1] = 1.0;
+    for (int i = n - 2; i >= 0; --i) {
+      double sum = -lu.lu[i * n + n - 1];
+      for (int k = i + 1; k < n - 1; ++k) sum -= lu.lu[i * n + k] * x[k];
+      x[i] = sum / lu.lu[i * n + i];
     }
+    const double scale = luDeterminant(lu, n - 1);
+    // Последняя строка L^-1: L^T * z = e_n
+    std::vector<double> z(n, 0.0);
+    z[n - 1] = 1.0;
+    for (int i = n - 2; i >= 0; --i) {
+      double sum = 0.0;
+      for (int k = i + 1; k < n; ++k) sum -= lu.lu[k * n + i] * z[k];
+      z[i] = sum;
+    }
+    // adj(A) = sign * (Q * x) * (z^T * P), дополнения - транспонированная adj
+    std::vector<double> qx(n), zp(n);
+    for (int j = 0; j < n; ++j) qx[lu.col_perm[j]] = scale * x[j];
+    for (int i = 0; i < n; ++i) zp[lu.row_perm[i]] = z[i];
+    Storage& out = *result.matrix_;
+    parallelFor(0, n, n, [&](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        for (int j = 0; j < n; ++j) out[i][j] = zp[i] * qx[j];
+      }
+    });
   }
   return result;
 }
 
 // Вычисление детерминанта
-double S21Matrix::Determinant() {
+double S21Matrix::Determinant() const {
   if (rows_ != cols_) {
     throw std::invalid_argument(
         "Matrix must be square to calculate determinant.");
   }
-  return determinantRecursive(*this);
+  if (!matrix_ || rows_ == 0) return 0.0;
+  double determinant = 0.0;
+  if (triangularDeterminant(determinant)) return determinant;
+  LUDecomposition lu = decomposeLU();
+  return lu.rank < rows_ ? 0.0 : luDeterminant(lu, rows_);
 }
 
 // Вычисление обратной матрицы
-S21Matrix S21Matrix::InverseMatrix() {
-  double det = Determinant();
-  if (det == 0) {
+S21Matrix S21Matrix::InverseMatrix() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Matrix must be square to calculate determinant.");
+  }
+  const int n = rows_;
+  LUDecomposition lu = decomposeLU();
+  if (lu.rank < n) {
     throw std::runtime_error("Matrix is singular and cannot be inverted.");
   }
-  S21Matrix complements = CalcComplements();
-  S21Matrix transposed = complements.Transpose();
-  transposed.MulNumber(1.0 / det);
-  return transposed;
+  S21Matrix result(n, n);
+  Storage& out = *result.matrix_;
+  parallelFor(0, n, static_cast<long long>(n) * n, [&](int from, int to) {
+    std::vector<double> x(n);
+    for (int c = from; c < to; ++c) {
+      luSolveColumn(lu, c, x);
+      for (int i = 0; i < n; ++i) out[i][c] = x[i];
+    }
+  });
+  return result;
+}
+
+// Асинхронные операции
+// Задача получает представление, разделяющее хранилище с операндами,
+// поэтому последующие изменения операндов не влияют на результат (ссылки
+// на элементы, полученные от operator() до вызова, для записи
+// использовать нельзя, как и после Transpose()).
+// Размеры операндов проверяются сразу при вызове, в future попадают только
+// ошибки самого вычисления (например, вырожденность матрицы).
+
+// Сумма
+std::future<S21Matrix> S21Matrix::SumMatrixAsync(
+    const S21Matrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Matrices dimensions are not equal.");
+  }
+  return S21ThreadPool::Instance().Submit(
+      [left = share(), right = other.share()]() { return left + right; });
+}
+
+// Разность
+std::future<S21Matrix> S21Matrix::SubMatrixAsync(
+    const S21Matrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Matrices dimensions are not equal.");
+  }
+  return S21ThreadPool::Instance().Submit(
+      [left = share(), right = other.share()]() { return left - right; });
+}
+
+// Произведение
+std::future<S21Matrix> S21Matrix::MulMatrixAsync(
+    const S21Matrix& other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument("Matrix dimensions are not comparable.");
+  }
+  return S21ThreadPool::Instance().Submit(
+      [left = share(), right = other.share()]() { return left * right; });
+}
+
+// Обратная матрица
+std::future<S21Matrix> S21Matrix::InverseMatrixAsync() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Matrix must be square to calculate determinant.");
+  }
+  return S21ThreadPool::Instance().Submit(
+      [matrix = share()]() { return matrix.InverseMatrix(); });
 }
 
 // Операторы
@@ -254,7 +492,12 @@ S21Matrix& S21Matrix::operator=(const S21Matrix& other) noexcept {
   if (this != &other) {
     rows_ = other.rows_;
     cols_ = other.cols_;
-    matrix_ = other.matrix_;
+    matrix_ = other.matrix_ ? copyStorage(*other.matrix_, other.memory_policy_,
+                                          other.node_)
+                            : nullptr;
+    transposed_ = other.transposed_;
+    memory_policy_ = other.memory_policy_;
+    node_ = other.node_;
   }
   return *this;
 }
@@ -265,8 +508,16 @@ S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
     rows_ = other.rows_;
     cols_ = other.cols_;
     matrix_ = std::move(other.matrix_);
+    transposed_ = other.transposed_;
+    reserved_cols_ = other.reserved_cols_;
+    memory_policy_ = other.memory_policy_;
+    node_ = other.node_;
     other.rows_ = 0;
     other.cols_ = 0;
+    other.transposed_ = false;
+    other.reserved_cols_ = 0;
+      other.memory_policy_ = S21MemoryPolicy::kFirstTouch;
+    other.node_ = 0;
   }
   return *this;
 }
@@ -296,11 +547,15 @@ S21Matrix& S21Matrix::operator*=(const double num) noexcept {
 }
 
 // Перегрузка оператора индексации ()
+// Ссылка указывает в хранилище, которое Transpose() и асинхронные
+// операции разделяют с матрицей: после них её нужно получить заново
+// (повторный вызов скопирует хранилище перед записью).
 double& S21Matrix::operator()(int i, int j) {
   if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
     throw std::out_of_range("Index out of range.");
   }
-  return matrix_[i][j];
+  detach();
+  return transposed_ ? (*matrix_)[j][i] : (*matrix_)[i][j];
 }
 
 // Перегрузка оператора индексации () для const объектов
@@ -308,39 +563,291 @@ const double& S21Matrix::operator()(int i, int j) const {
   if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
     throw std::out_of_range("Index out of range.");
   }
-  return matrix_[i][j];
+  return transposed_ ? (*matrix_)[j][i] : (*matrix_)[i][j];
 }
 
 // Приватные вспомогательные функции
 
-// Рекурсивное вычисление детерминанта
-// Calculate matrix determinant (recursive method)
-double S21Matrix::determinantRecursive(const S21Matrix& other) const {
-  if (other.rows_ == 1) return other.matrix_[0][0];
-  if (other.rows_ == 2) {
-    return other.matrix_[0][0] * other.matrix_[1][1] -
-           other.matrix_[0][1] * other.matrix_[1][0];
+// Выделение нулевых строк rows_ x cols_ с размещением placeRows.
+// Строки создаются пустыми с аллокатором политики страниц, память
+// выделяется и заполняется уже при assign.
+void S21Matrix::allocate(S21MemoryPolicy policy, int node,
+                         S21PagePolicy pages) {
+  const Row::allocator_type allocator =
+      rowAllocator(pages, policy, node, rows_, cols_);
+  matrix_ = std::make_shared<Storage>();
+  matrix_->reserve(rows_);
+  for (int i = 0; i < rows_; ++i) matrix_->emplace_back(allocator);
+  Storage& storage = *matrix_;
+  const int cols = cols_;
+  placeRows(rows_, cols, policy,
+            [&storage, cols](int i) { storage[i].assign(cols, 0.0); });
+}
+
+// Заполнение строк 0..rows-1 функцией fill с размещением по узлам NUMA.
+// При kFirstTouch часть t строк заполняет рабочий поток t пула
+// (ParallelForPinned), и их страницы оказываются на его узле. Обычные
+// параллельные циклы делят строки так же, но их части могут перехватить
+// другие потоки, поэтому локальность там не гарантируется. При
+// kInterleave и kBind строки лежат в области с политикой mbind
+// (rowAllocator), и заполнять их может любой поток.
+void S21Matrix::placeRows(int rows, long long cost, S21MemoryPolicy policy,
+                          const std::function<void(int)>& fill) {
+  const auto part = [&fill](int from, int to) {
+    for (int i = from; i < to; ++i) fill(i);
+  };
+  if (policy == S21MemoryPolicy::kFirstTouch) {
+    S21ThreadPool::Instance().ParallelForPinned(0, rows, cost, part);
+  } else {
+    S21ThreadPool::Instance().ParallelFor(0, rows, cost, part);
   }
-  double det = 0.0;
-  for (int i = 0; i < other.cols_; ++i) {
-    S21Matrix submatrix = other.minor(0, i);
-    det += ((i % 2 == 0 ? 1 : -1) * other.matrix_[0][i] *
-            determinantRecursive(submatrix));
+}
+
+// Аллокатор строк для политики страниц и политики NUMA: при
+// huge-страницах, kInterleave или kBind - новая область с участком под
+// rows строк по cols элементов. Строки, которые позже добавят SetRows и
+// AppendRow или удлинит SetCols, берут тот же аллокатор и ту же политику.
+S21Matrix::Row::allocator_type S21Matrix::rowAllocator(S21PagePolicy pages,
+                                                       S21MemoryPolicy policy,
+                                                       int node, int rows,
+                                                       int cols) {
+  if (pages == S21PagePolicy::kDefault &&
+      policy == S21MemoryPolicy::kFirstTouch) {
+    return Row::allocator_type();
   }
-  return det;
+  auto arena = std::make_shared<S21PageArena>(pages, policy, node);
+  arena->Reserve(static_cast<size_t>(rows),
+                 static_cast<size_t>(cols) * sizeof(double));
+  return Row::allocator_type(std::move(arena));
+}
+
+// Копия хранилища с той же политикой страниц, строки которой копируются
+// и размещаются по узлам NUMA так же, как при создании матрицы
+std::shared_ptr<S21Matrix::Storage> S21Matrix::copyStorage(
+    const Storage& source, S21MemoryPolicy policy, int node) {
+  const int rows = static_cast<int>(source.size());
+  const int cols = rows > 0 ? static_cast<int>(source[0].size()) : 0;
+  const S21PageArena* arena =
+      rows > 0 ? source[0].get_allocator().Arena().get() : nullptr;
+  const Row::allocator_type allocator =
+      rowAllocator(arena ? arena->Policy() : S21PagePolicy::kDefault, policy,
+                   node, rows, cols);
+  auto result = std::make_shared<Storage>();
+  result->reserve(rows);
+  for (int i = 0; i < rows; ++i) result->emplace_back(allocator);
+  Storage& storage = *result;
+  placeRows(rows, cols, policy,
+            [&storage, &source](int i) { storage[i] = source[i]; });
+  return result;
+}
+
+// Представление, разделяющее хранилище с матрицей
+S21Matrix S21Matrix::share() const {
+  S21Matrix result;
+  result.rows_ = rows_;
+  result.cols_ = cols_;
+  result.matrix_ = matrix_;
+  result.transposed_ = transposed_;
+  result.memory_policy_ = memory_policy_;
+  result.node_ = node_;
+  return result;
+}
+
+// Представление с построчным расположением данных: без копирования, если
+// хранилище уже построчное, иначе материализованная копия
+S21Matrix S21Matrix::rowMajor() const {
+  S21Matrix result = share();
+  if (transposed_) result.Materialize();
+  return result;
+}
+
+// Определитель треугольной матрицы как произведение диагонали.
+// Проверка прерывается на первом ненулевом элементе по обе стороны
+// от диагонали, так что для плотных матриц она почти ничего не стоит.
+bool S21Matrix::triangularDeterminant(double& determinant) const {
+  const Storage& storage = *matrix_;
+  bool lower = true, upper = true;
+  for (int i = 0; i < rows_ && (lower || upper); ++i) {
+    const Row& row = storage[i];
+    for (int j = 0; j < i && upper; ++j) upper = row[j] == 0.0;
+    for (int j = i + 1; j < cols_ && lower; ++j) lower = row[j] == 0.0;
+  }
+  if (!lower && !upper) return false;
+  determinant = 1.0;
+  for (int i = 0; i < rows_; ++i) determinant *= storage[i][i];
+  return true;
+}
+
+// Новая нулевая строка длины cols_ с учётом зарезервированной ёмкости
+// Строка берёт аллокатор уже существующих строк (ту же область)
+S21Matrix::Row S21Matrix::newRow() const {
+  Row row(matrix_ && !matrix_->empty() ? matrix_->front().get_allocator()
+                                       : Row::allocator_type());
+  row.reserve(std::max(cols_, reserved_cols_));
+  row.resize(cols_, 0.0);
+  return row;
+}
+
+// Копирование разделяемого хранилища перед записью
+void S21Matrix::detach() {
+  if (matrix_ && matrix_.use_count() > 1) {
+    matrix_ = copyStorage(*matrix_, memory_policy_, node_);
+  }
+}
+
+// Произведение c = a * b, где a - rows x inner, b - inner x cols
+// (с учётом флагов транспонирования), c - обычная матрица rows x cols.
+// Внутренний цикл всегда идёт по непрерывной памяти, строки c
+// распределяются между потоками.
+void S21Matrix::multiplyKernel(const Storage& a, bool a_transposed,
+                               const Storage& b, bool b_transposed, Storage& c,
+                               int rows, int inner, int cols) {
+  const long long cost = static_cast<long long>(inner) * cols;
+  parallelFor(0, rows, cost, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      double* line = c[i].data();
+      if (b_transposed) {
+        // Скалярные произведения строки a на строки хранилища b
+        for (int j = 0; j < cols; ++j) {
+          const double* column = b[j].data();
+          double sum = 0.0;
+          if (a_transposed) {
+            for (int k = 0; k < inner; ++k) sum += a[k][i] * column[k];
+          } else {
+            const double* row = a[i].data();
+            for (int k = 0; k < inner; ++k) sum += row[k] * column[k];
+          }
+          line[j] = sum;
+        }
+      } else {
+        for (int k = 0; k < inner; ++k) {
+          const double factor = a_transposed ? a[k][i] : a[i][k];
+          const double* row = b[k].data();
+          for (int j = 0; j < cols; ++j) line[j] += factor * row[j];
+        }
+      }
+    }
+  });
 }
 
-// Calculate matrix minor
-S21Matrix S21Matrix::minor(int row, int col) const {
-  S21Matrix result(rows_ - 1, cols_ - 1);
-  for (int i = 0, m = 0; i < rows_; ++i) {
-    if (i == row) continue;
-    for (int j = 0, n = 0; j < cols_; ++j) {
-      if (j == col) continue;
-      result.matrix_[m][n] = matrix_[i][j];
-      ++n;
+// LU-разложение с полным выбором ведущего элемента.
+// Разложение останавливается только на точно нулевом ведущем элементе
+// (rank). Ведущие элементы, не превосходящие n * eps * |u_00|, отмечаются
+// в numerical_rank, он нужен лишь для выбора формулы в CalcComplements.
+S21Matrix::LUDecomposition S21Matrix::decomposeLU() const {
+  const int n = rows_;
+  LUDecomposition result;
+  result.size = n;
+  result.rank = n;
+  result.numerical_rank = n;
+  result.lu.resize(static_cast<size_t>(n) * n);
+  result.row_perm.resize(n);
+  result.col_perm.resize(n);
+  const Storage& source = *matrix_;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      result.lu[i * n + j] = transposed_ ? source[j][i] : source[i][j];
+    }
+    result.row_perm[i] = i;
+    result.col_perm[i] = i;
+  }
+  double* a = result.lu.data();
+  double tolerance = 0.0;
+  for (int k = 0; k < n; ++k) {
+    int pivot_row = k, pivot_col = k;
+    double pivot = 0.0;
+    for (int i = k; i < n; ++i) {
+      for (int j = k; j < n; ++j) {
+        if (std::abs(a[i * n + j]) > pivot) {
+          pivot = std::abs(a[i * n + j]);
+          pivot_row = i;
+          pivot_col = j;
+        }
+      }
+    }
+    if (k == 0) tolerance = n * std::numeric_limits<double>::epsilon() * pivot;
+    if (pivot <= tolerance && result.numerical_rank == n) {
+      result.numerical_rank = k;
+    }
+    if (pivot == 0.0) {
+      result.rank = k;
+      break;
+    }
+    if (pivot_row != k) {
+      std::swap_ranges(a + k * n, a + (k + 1) * n, a + pivot_row * n);
+      std::swap(result.row_perm[k], result.row_perm[pivot_row]);
+      result.sign = -result.sign;
+    }
+    if (pivot_col != k) {
+      for (int i = 0; i < n; ++i) std::swap(a[i * n + k], a[i * n + pivot_col]);
+      std::swap(result.col_perm[k], result.col_perm[pivot_col]);
+      result.sign = -result.sign;
     }
-    ++m;
+    const double* pivot_line = a + k * n;
+    parallelFor(k + 1, n, n - k, [=](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        double* line = a + i * n;
+        const double factor = line[k] / pivot_line[k];
+        line[k] = factor;
+        for (int j = k + 1; j < n; ++j) line[j] -= factor * pivot_line[j];
+      }
+    });
   }
   return result;
 }
+
+// Детерминант по первым count ведущим элементам разложения
+double S21Matrix::luDeterminant(const LUDecomposition& lu, int count) {
+  double det = lu.sign;
+  for (int i = 0; i < count; ++i) det *= lu.lu[i * lu.size + i];
+  return det;
+}
+
+// Решение A * x = e_col по готовому разложению (A^-1 = Q * U^-1 * L^-1 * P)
+void S21Matrix::luSolveColumn(const LUDecomposition& lu, int col,
+                              std::vector<double>& x) {
+  const int n = lu.size;
+  const double* a = lu.lu.data();
+  std::vector<double> y(n);
+  for (int i = 0; i < n; ++i) {
+    double sum = lu.row_perm[i] == col ? 1.0 : 0.0;
+    for (int k = 0; k < i; ++k) sum -= a[i * n + k] * y[k];
+    y[i] = sum;
+  }
+  for (int i = n - 1; i >= 0; --i) {
+    double sum = y[i];
+    for (int k = i + 1; k < n; ++k) sum -= a[i * n + k] * y[k];
+    y[i] = sum / a[i * n + i];
+  }
+  for (int j = 0; j < n; ++j) x[lu.col_perm[j]] = y[j];
+}
+
+// Решение A * X = rhs по LU-разложению A для cols столбцов правой части.
+// Столбцы решаются независимо и делятся между потоками.
+void S21Matrix::luSolve(const LUDecomposition& lu, const Storage& rhs,
+                        Storage& out, int cols) {
+  const int n = lu.size;
+  const double* a = lu.lu.data();
+  parallelFor(0, cols, static_cast<long long>(n) * n, [&](int from, int to) {
+    std::vector<double> y(n);
+    for (int c = from; c < to; ++c) {
+      for (int i = 0; i < n; ++i) {
+        double sum = rhs[lu.row_perm[i]][c];
+        for (int k = 0; k < i; ++k) sum -= a[i * n + k] * y[k];
+        y[i] = sum;
+      }
+      for (int i = n - 1; i >= 0; --i) {
+        double sum = y[i];
+        for (int k = i + 1; k < n; ++k) sum -= a[i * n + k] * y[k];
+        y[i] = sum / a[i * n + i];
+      }
+      for (int j = 0; j < n; ++j) out[lu.col_perm[j]][c] = y[j];
+    }
+  });
+}
+
+// Параллельный цикл на общем пуле потоков
+void S21Matrix::parallelFor(int begin, int end, long long cost,
+                            const std::function<void(int, int)>& body) {
+  S21ThreadPool::Instance().ParallelFor(begin, end, cost, body);
+}
@@ -2,33 +2,102 @@
 #define S21_MATRIX_H
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "s21_aligned_allocator.h"
+#include "s21_numa.h"
+
+// Способ чтения файла: целиком в память или отображением (mmap)
+enum class S21FileMode { kRead, kMemoryMap };
+
+struct S21EigenDecomposition;
+struct S21SingularValueDecomposition;
+
 class S21Matrix {
+  friend class S21TaskGraph;
+  friend class S21TriangularMatrix;
+  friend class S21SymmetricMatrix;
+  friend class S21BandMatrix;
+  friend class S21PanelUpdate;
+
  private:
+  // Строки выровнены на 64 байта; при политике huge-страниц или
+  // kInterleave/kBind все строки матрицы нарезаются из одной общей
+  // области (S21PageArena)
+  using Row = std::vector<double, S21AlignedAllocator<double>>;
+  using Storage = std::vector<Row>;
+
   int rows_;
   int cols_;
-  std::vector<std::vector<double>> matrix_;
+  // Хранилище может разделяться с транспонированными представлениями,
+  // перед записью оно копируется (detach)
+  std::shared_ptr<Storage> matrix_;
+  // Данные лежат в хранилище в транспонированном виде (cols_ x rows_)
+  bool transposed_;
+  // Зарезервированная длина строк, добавляемых при росте матрицы
+  int reserved_cols_;
+  // Размещение строк по узлам NUMA, с которым создаются и копии
+  S21MemoryPolicy memory_policy_;
+  int node_;
 
  public:
   // Methods
   S21Matrix() noexcept;
   S21Matrix(int rows, int cols);
+  S21Matrix(int rows, int cols, S21MemoryPolicy policy, int node = 0,
+            S21PagePolicy pages = S21PagePolicy::kDefault);
+  S21Matrix(int rows, int cols, S21PagePolicy pages);
   S21Matrix(const S21Matrix& other);
   S21Matrix(S21Matrix&& other) noexcept;
   ~S21Matrix();
   // Operations
   bool EqMatrix(const S21Matrix& other) const;
+  bool EqMatrix(const S21Matrix& other, double abs_tolerance,
+                double rel_tolerance) const;
   void SumMatrix(const S21Matrix& other);
   void SubMatrix(const S21Matrix& other);
   void MulNumber(const double num);
   void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
+  S21Matrix Transpose() const;
+  S21Matrix CalcComplements() const;
+  double Determinant() const;
+  S21Matrix InverseMatrix() const;
+  S21Matrix Pow(int k) const;
+  S21Matrix Exp() const;
+  void Materialize();
+  // Редукции
+  double Trace() const;
+  double FrobeniusNorm() const;
+  double OneNorm() const;
+  double InfNorm() const;
+  double Min() const;
+  double Max() const;
+  double MaxAbsDiff(const S21Matrix& other) const;
+  S21Matrix RowSums() const;
+  S21Matrix ColSums() const;
+  // Разложения
+  S21EigenDecomposition SymmetricEigen() const;
+  S21SingularValueDecomposition SVD() const;
+  S21SingularValueDecomposition TruncatedSVD(int rank, int oversampling = 10,
+                                             int power_iterations = 2) const;
+  // Ввод-вывод в текстовом виде (CSV или значения через пробел)
+  static S21Matrix FromCSV(const std::string& path, char delimiter = ',',
+                           S21FileMode mode = S21FileMode::kMemoryMap);
+  static S21Matrix ParseCSV(std::string_view text, char delimiter = ',');
+  void ToCSV(const std::string& path, char delimiter = ',') const;
+  void ToCSV(std::ostream& output, char delimiter = ',') const;
+  // Асинхронные операции на общем пуле потоков
+  std::future<S21Matrix> SumMatrixAsync(const S21Matrix& other) const;
+  std::future<S21Matrix> SubMatrixAsync(const S21Matrix& other) const;
+  std::future<S21Matrix> MulMatrixAsync(const S21Matrix& other) const;
+  std::future<S21Matrix> InverseMatrixAsync() const;
   // Operators
   S21Matrix operator+(const S21Matrix& other) const;
   S21Matrix operator-(const S21Matrix& other) const;
@@ -47,15 +116,76 @@ class S21Matrix {
   int getRows() const noexcept;
   int getCols() const noexcept;
   double getElement(int row, int col) const;
+  bool IsTransposed() const noexcept;
+  S21PagePolicy PagePolicy() const noexcept;
+  bool HugePages() const noexcept;
   // Setters
   void SetRows(int rows);
   void SetCols(int cols);
   void SetDimensions(int rows, int cols);
   void SetElement(int row, int col, double value);
+  void Reserve(int rows, int cols);
+  void AppendRow(const double* values, int count);
+  void AppendRow(const std::vector<double>& row);
 
  private:
-  S21Matrix minor(int row, int col) const;
-  double determinantRecursive(const S21Matrix& other) const;
+  void allocate(S21MemoryPolicy policy, int node, S21PagePolicy pages);
+  static Row::allocator_type rowAllocator(S21PagePolicy pages,
+                                          S21MemoryPolicy policy, int node,
+                                          int rows, int cols);
+  static std::shared_ptr<Storage> copyStorage(const Storage& source,
+                                              S21MemoryPolicy policy,
+                                              int node);
+  static void placeRows(int rows, long long cost, S21MemoryPolicy policy,
+                        const std::function<void(int)>& fill);
+  S21Matrix share() const;
+  S21Matrix rowMajor() const;
+  bool triangularDeterminant(double& determinant) const;
+  Row newRow() const;
+  void detach();
+  double reduceRows(const std::function<double(int)>& row_value,
+                    const std::function<double(double, double)>& combine,
+                    double init) const;
+  std::vector<double> physicalColumnSums(bool absolute) const;
+  std::vector<double> physicalRowSums(bool absolute) const;
+  static void multiplyKernel(const Storage& a, bool a_transposed,
+                             const Storage& b, bool b_transposed, Storage& c,
+                             int rows, int inner, int cols);
+  static void multiplyInto(const Storage& a, const Storage& b, Storage& c,
+                           int size);
+
+  // LU-разложение с полным выбором ведущего элемента: P * A * Q = L * U
+  struct LUDecomposition {
+    int size = 0;
+    int rank = 0;            // число ненулевых ведущих элементов
+    int numerical_rank = 0;  // число ведущих элементов выше допуска
+    int sign = 1;
+    std::vector<double> lu;      // L (без единичной диагонали) и U, построчно
+    std::vector<int> row_perm;   // строка i матрицы PAQ = строка row_perm[i]
+    std::vector<int> col_perm;   // столбец j матрицы PAQ = столбец col_perm[j]
+  };
+
+  LUDecomposition decomposeLU() const;
+  static double luDeterminant(const LUDecomposition& lu, int count);
+  static void luSolveColumn(const LUDecomposition& lu, int col,
+                            std::vector<double>& x);
+  static void luSolve(const LUDecomposition& lu, const Storage& rhs,
+                      Storage& out, int cols);
+  static void parallelFor(int begin, int end, long long cost,
+                          const std::function<void(int, int)>& body);
+};
+
+// Спектральное разложение симметричной матрицы A = V * diag(values) * V^T
+struct S21EigenDecomposition {
+  S21Matrix values;   // собственные значения по возрастанию, n x 1
+  S21Matrix vectors;  // собственные векторы по столбцам, n x n
+};
+
+// Сингулярное разложение A = U * diag(values) * V^T
+struct S21SingularValueDecomposition {
+  S21Matrix u;       // левые сингулярные векторы по столбцам, m x k
+  S21Matrix values;  // сингулярные числа по убыванию, k x 1
+  S21Matrix v;       // правые сингулярные векторы по столбцам, n x k
 };
 
 #endif
\ No newline at end of file
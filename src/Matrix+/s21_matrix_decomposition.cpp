@@ -0,0 +1,590 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "s21_matrix.h"
+#include "s21_thread_pool.h"
+
+// Отложенное обновление хвостовой подматрицы после панели блочных
+// разложений: a[row_start.., col_start..] -= left * right, где left -
+// rows x inner, right - inner x cols (inner = 2 * ширина панели).
+// Множители упаковываются прямо в строки хранилища, произведение считает
+// общее ядро умножения S21Matrix.
+class S21PanelUpdate {
+ public:
+  S21PanelUpdate(int rows, int cols, int inner)
+      : rows_(rows),
+        cols_(cols),
+        left_(rows, S21Matrix::Row(inner)),
+        right_(inner, S21Matrix::Row(cols)) {}
+
+  double* Left(int row) { return left_[row].data(); }
+  double* Right(int row) { return right_[row].data(); }
+
+  void SubtractFrom(std::vector<double>& a, int n, int row_start,
+                    int col_start) const {
+    S21Matrix::Storage product(rows_, S21Matrix::Row(cols_));
+    S21Matrix::multiplyKernel(left_, false, right_, false, product, rows_,
+                              static_cast<int>(right_.size()), cols_);
+    const int cols = cols_;
+    S21Matrix::parallelFor(0, rows_, cols, [&](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        double* line = &a[static_cast<size_t>(row_start + i) * n + col_start];
+        const double* row = product[i].data();
+        for (int j = 0; j < cols; ++j) line[j] -= row[j];
+      }
+    });
+  }
+
+ private:
+  int rows_;
+  int cols_;
+  S21Matrix::Storage left_;
+  S21Matrix::Storage right_;
+};
+
+namespace {
+// Ширина панели в блочных отражениях Хаусхолдера
+constexpr int kBlockSize = 32;
+constexpr int kMaxIterations = 75;
+
+using Flat = std::vector<double>;
+
+// Копия матрицы в непрерывный построчный массив
+Flat toFlat(const S21Matrix& matrix) {
+  const int rows = matrix.getRows(), cols = matrix.getCols();
+  Flat result(static_cast<size_t>(rows) * cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) result[i * cols + j] = matrix(i, j);
+  }
+  return result;
+}
+
+S21Matrix fromFlat(const Flat& values, int rows, int cols) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) result(i, j) = values[i * cols + j];
+  }
+  return result;
+}
+
+// Отражение Хаусхолдера H = I - tau * v * v^T, переводящее вектор
+// (x[alpha], x[first], x[first + stride], ...) в (beta, 0, ...).
+// На месте остаются beta и хвост v (первый элемент v равен 1).
+double householder(Flat& x, size_t alpha, size_t first, int count,
+                   size_t stride) {
+  double norm = 0.0;
+  for (int i = 0; i < count; ++i) {
+    norm += x[first + i * stride] * x[first + i * stride];
+  }
+  if (norm == 0.0) return 0.0;
+  const double beta = -std::copysign(std::sqrt(x[alpha] * x[alpha] + norm),
+                                     x[alpha]);
+  const double tau = (beta - x[alpha]) / beta;
+  const double scale = 1.0 / (x[alpha] - beta);
+  for (int i = 0; i < count; ++i) x[first + i * stride] *= scale;
+  x[alpha] = beta;
+  return tau;
+}
+
+// Произведение отражений H_0 * ... * H_{count-1} (первые cols столбцов),
+// вектор v_j начинается в строке j + shift с единицы, остальные его
+// элементы возвращает element(j, row). Отражения применяются с конца,
+// поэтому каждое затрагивает только правый нижний угол результата.
+Flat accumulateReflectors(int rows, int cols, int count, int shift,
+                          const Flat& tau,
+                          const std::function<double(int, int)>& element) {
+  Flat q(static_cast<size_t>(rows) * cols, 0.0);
+  for (int i = 0; i < std::min(rows, cols); ++i) q[i * cols + i] = 1.0;
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  Flat v(rows), sums(cols);
+  for (int j = count - 1; j >= 0; --j) {
+    const int start = j + shift;
+    if (start >= rows || start >= cols || tau[j] == 0.0) continue;
+    v[start] = 1.0;
+    for (int r = start + 1; r < rows; ++r) v[r] = element(j, r);
+    const long long cost = rows - start;
+    pool.ParallelFor(start, cols, cost, [&](int from, int to) {
+      for (int c = from; c < to; ++c) sums[c] = 0.0;
+      for (int r = start; r < rows; ++r) {
+        const double* line = &q[static_cast<size_t>(r) * cols];
+        for (int c = from; c < to; ++c) sums[c] += v[r] * line[c];
+      }
+    });
+    pool.ParallelFor(start, rows, cols - start, [&](int from, int to) {
+      for (int r = from; r < to; ++r) {
+        double* line = &q[static_cast<size_t>(r) * cols];
+        const double factor = tau[j] * v[r];
+        for (int c = start; c < cols; ++c) line[c] -= factor * sums[c];
+      }
+    });
+  }
+  return q;
+}
+
+// Блочное приведение симметричной матрицы n x n к трёхдиагональному виду
+// A = Q * T * Q^T. Панель из kBlockSize столбцов обрабатывается по схеме
+// LAPACK xLATRD: столбцы панели обновляются по мере надобности через
+// накопленные V и W, а хвостовая подматрица - одним произведением
+// A -= V * W^T + W * V^T. Векторы отражений остаются под поддиагональю.
+void tridiagonalize(Flat& a, int n, Flat& d, Flat& e, Flat& tau) {
+  d.assign(n, 0.0);
+  e.assign(n, 0.0);
+  tau.assign(n, 0.0);
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  for (int k = 0; k < n - 1;) {
+    const int nb = std::min(kBlockSize, n - 1 - k);
+    Flat w(static_cast<size_t>(n - k) * nb, 0.0);
+    auto V = [&](int r, int j) -> double& { return a[r * n + k + j]; };
+    auto W = [&](int r, int j) -> double& { return w[(r - k) * nb + j]; };
+    for (int i = 0; i < nb; ++i) {
+      const int g = k + i;
+      for (int r = g; r < n; ++r) {
+        double sum = 0.0;
+        for (int j = 0; j < i; ++j) sum += V(r, j) * W(g, j) + W(r, j) * V(g, j);
+        a[r * n + g] -= sum;
+      }
+      d[g] = a[g * n + g];
+      tau[g] = householder(a, (g + 1) * n + g, (g + 2) * n + g, n - g - 2, n);
+      e[g] = a[(g + 1) * n + g];
+      a[(g + 1) * n + g] = 1.0;
+
+      const int len = n - g - 1;
+      Flat v(len), wcol(len), t1(i, 0.0), t2(i, 0.0);
+      for (int r = 0; r < len; ++r) v[r] = a[(g + 1 + r) * n + g];
+      pool.ParallelFor(0, len, len, [&](int from, int to) {
+        for (int r = from; r < to; ++r) {
+          const double* line = &a[(g + 1 + r) * n + g + 1];
+          double sum = 0.0;
+          for (int c = 0; c < len; ++c) sum += line[c] * v[c];
+          wcol[r] = sum;
+        }
+      });
+      for (int r = 0; r < len; ++r) {
+        for (int j = 0; j < i; ++j) {
+          t1[j] += W(g + 1 + r, j) * v[r];
+          t2[j] += V(g + 1 + r, j) * v[r];
+        }
+      }
+      double dot = 0.0;
+      for (int r = 0; r < len; ++r) {
+        double sum = 0.0;
+        for (int j = 0; j < i; ++j) {
+          sum += V(g + 1 + r, j) * t1[j] + W(g + 1 + r, j) * t2[j];
+        }
+        wcol[r] = tau[g] * (wcol[r] - sum);
+        dot += wcol[r] * v[r];
+      }
+      const double alpha = -0.5 * tau[g] * dot;
+      for (int r = 0; r < len; ++r) W(g + 1 + r, i) = wcol[r] + alpha * v[r];
+    }
+    const int start = k + nb, size = n - start;
+    S21PanelUpdate update(size, size, 2 * nb);
+    for (int r = 0; r < size; ++r) {
+      double* left = update.Left(r);
+      for (int j = 0; j < nb; ++j) {
+        left[j] = update.Right(nb + j)[r] = V(start + r, j);
+        left[nb + j] = update.Right(j)[r] = W(start + r, j);
+      }
+    }
+    update.SubtractFrom(a, n, start, start);
+    k = start;
+  }
+  d[n - 1] = a[(n - 1) * n + n - 1];
+}
+
+// Неявный QL-алгоритм со сдвигами для трёхдиагональной матрицы
+// (d - диагональ, e[i] - элемент (i, i + 1)), вращения накапливаются
+// в столбцах z. Схема tql2 из EISPACK.
+void tridiagonalQL(Flat& d, Flat& e, Flat& z, int n) {
+  const double eps = std::numeric_limits<double>::epsilon();
+  double f = 0.0, norm = 0.0;
+  for (int l = 0; l < n; ++l) {
+    norm = std::max(norm, std::abs(d[l]) + std::abs(e[l]));
+    int m = l;
+    while (m < n - 1 && std::abs(e[m]) > eps * norm) ++m;
+    int iterations = 0;
+    while (m > l) {
+      if (++iterations > kMaxIterations) {
+        throw std::runtime_error("Decomposition did not converge.");
+      }
+      double g = d[l];
+      double p = (d[l + 1] - g) / (2.0 * e[l]);
+      double r = std::copysign(std::hypot(p, 1.0), p);
+      d[l] = e[l] / (p + r);
+      d[l + 1] = e[l] * (p + r);
+      const double dl1 = d[l + 1];
+      double h = g - d[l];
+      for (int i = l + 2; i < n; ++i) d[i] -= h;
+      f += h;
+      p = d[m];
+      double c = 1.0, c2 = 1.0, c3 = 1.0, s = 0.0, s2 = 0.0;
+      const double el1 = e[l + 1];
+      for (int i = m - 1; i >= l; --i) {
+        c3 = c2;
+        c2 = c;
+        s2 = s;
+        g = c * e[i];
+        h = c * p;
+        r = std::hypot(p, e[i]);
+        e[i + 1] = s * r;
+        s = e[i] / r;
+        c = p / r;
+        p = c * d[i] - s * g;
+        d[i + 1] = h + s * (c * g + s * d[i]);
+        for (int k = 0; k < n; ++k) {
+          double* line = &z[k * n];
+          h = line[i + 1];
+          line[i + 1] = s * line[i] + c * h;
+          line[i] = c * line[i] - s * h;
+        }
+      }
+      p = -s * s2 * c3 * el1 * e[l] / dl1;
+      e[l] = s * p;
+      d[l] = c * p;
+      if (std::abs(e[l]) <= eps * norm) break;
+    }
+    d[l] += f;
+    e[l] = 0.0;
+  }
+}
+
+// Блочное приведение матрицы m x n (m >= n) к верхней двухдиагональной
+// A = Q * B * P^T по схеме LAPACK xLABRD/xGEBRD: панель накапливает X и Y,
+// хвостовая подматрица обновляется произведением A -= V * Y^T + X * U^T.
+// Векторы левых отражений остаются под диагональю, правых - правее
+// наддиагонали.
+void bidiagonalize(Flat& a, int m, int n, Flat& d, Flat& e, Flat& tauq,
+                   Flat& taup) {
+  d.assign(n, 0.0);
+  e.assign(n, 0.0);
+  tauq.assign(n, 0.0);
+  taup.assign(n, 0.0);
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  for (int k = 0; k < n;) {
+    const int nb = std::min(kBlockSize, n - k);
+    Flat x(static_cast<size_t>(m - k) * nb, 0.0);
+    Flat y(static_cast<size_t>(n - k) * nb, 0.0);
+    auto A = [&](int r, int c) -> double& { return a[r * n + c]; };
+    auto X = [&](int r, int j) -> double& { return x[(r - k) * nb + j]; };
+    auto Y = [&](int c, int j) -> double& { return y[(c - k) * nb + j]; };
+    for (int i = 0; i < nb; ++i) {
+      const int g = k + i;
+      for (int r = g; r < m; ++r) {
+        double sum = 0.0;
+        for (int j = 0; j < i; ++j) {
+          sum += A(r, k + j) * Y(g, j) + X(r, j) * A(k + j, g);
+        }
+        A(r, g) -= sum;
+      }
+      tauq[g] = householder(a, g * n + g, (g + 1) * n + g, m - g - 1, n);
+      d[g] = A(g, g);
+      if (g == n - 1) continue;
+      A(g, g) = 1.0;
+
+      // Y(g+1:n, i)
+      const int cols = n - g - 1;
+      Flat ycol(cols, 0.0), t(i + 1, 0.0);
+      pool.ParallelFor(0, cols, m - g, [&](int from, int to) {
+        for (int r = g; r < m; ++r) {
+          const double u = A(r, g);
+          const double* line = &a[r * n + g + 1];
+          for (int c = from; c < to; ++c) ycol[c] += line[c] * u;
+        }
+      });
+      for (int j = 0; j < i; ++j) {
+        for (int r = g; r < m; ++r) t[j] += A(r, k + j) * A(r, g);
+      }
+      for (int c = 0; c < cols; ++c) {
+        for (int j = 0; j < i; ++j) ycol[c] -= Y(g + 1 + c, j) * t[j];
+      }
+      std::fill(t.begin(), t.end(), 0.0);
+      for (int j = 0; j < i; ++j) {
+        for (int r = g; r < m; ++r) t[j] += X(r, j) * A(r, g);
+      }
+      for (int c = 0; c < cols; ++c) {
+        for (int j = 0; j < i; ++j) ycol[c] -= A(k + j, g + 1 + c) * t[j];
+        Y(g + 1 + c, i) = tauq[g] * ycol[c];
+      }
+
+      // Строка g и правое отражение
+      for (int c = g + 1; c < n; ++c) {
+        double sum = 0.0;
+        for (int j = 0; j <= i; ++j) sum += Y(c, j) * A(g, k + j);
+        for (int j = 0; j < i; ++j) sum += A(k + j, c) * X(g, j);
+        A(g, c) -= sum;
+      }
+      taup[g] = householder(a, g * n + g + 1, g * n + g + 2, n - g - 2, 1);
+      e[g] = A(g, g + 1);
+      A(g, g + 1) = 1.0;
+
+      // X(g+1:m, i)
+      const int rows = m - g - 1;
+      Flat xcol(rows), t2(i, 0.0);
+      std::fill(t.begin(), t.end(), 0.0);
+      pool.ParallelFor(0, rows, cols, [&](int from, int to) {
+        for (int r = from; r < to; ++r) {
+          const double* line = &a[(g + 1 + r) * n + g + 1];
+          double sum = 0.0;
+          for (int c = 0; c < cols; ++c) sum += line[c] * A(g, g + 1 + c);
+          xcol[r] = sum;
+        }
+      });
+      for (int c = g + 1; c < n; ++c) {
+        for (int j = 0; j <= i; ++j) t[j] += Y(c, j) * A(g, c);
+        for (int j = 0; j < i; ++j) t2[j] += A(k + j, c) * A(g, c);
+      }
+      for (int r = 0; r < rows; ++r) {
+        double sum = 0.0;
+        for (int j = 0; j <= i; ++j) sum += A(g + 1 + r, k + j) * t[j];
+        for (int j = 0; j < i; ++j) sum += X(g + 1 + r, j) * t2[j];
+        X(g + 1 + r, i) = taup[g] * (xcol[r] - sum);
+      }
+    }
+    const int row_start = k + nb, col_start = k + nb;
+    const int rows = m - row_start, cols = n - col_start;
+    if (rows > 0 && cols > 0) {
+      S21PanelUpdate update(rows, cols, 2 * nb);
+      for (int r = 0; r < rows; ++r) {
+        double* left = update.Left(r);
+        for (int j = 0; j < nb; ++j) {
+          left[j] = A(row_start + r, k + j);
+          left[nb + j] = X(row_start + r, j);
+        }
+      }
+      for (int j = 0; j < nb; ++j) {
+        double* y = update.Right(j);
+        double* u = update.Right(nb + j);
+        for (int c = 0; c < cols; ++c) {
+          y[c] = Y(col_start + c, j);
+          u[c] = A(k + j, col_start + c);
+        }
+      }
+      update.SubtractFrom(a, n, row_start, col_start);
+    }
+    k = row_start;
+  }
+}
+
+// QR-алгоритм Голуба-Кахана для двухдиагональной матрицы (d - диагональ,
+// e[i] - элемент (i, i + 1)) с накоплением вращений в u (m x n) и v (n x n)
+void bidiagonalQR(Flat& d, const Flat& e, Flat& u, Flat& v, int m, int n) {
+  const double eps = std::numeric_limits<double>::epsilon();
+  // rv1[i] - наддиагональный элемент (i - 1, i)
+  Flat rv1(n, 0.0);
+  for (int i = 1; i < n; ++i) rv1[i] = e[i - 1];
+  double norm = 0.0;
+  for (int i = 0; i < n; ++i) {
+    norm = std::max(norm, std::abs(d[i]) + std::abs(rv1[i]));
+  }
+  auto rotate = [](Flat& q, int rows, int cols, int p, int s, double c,
+                   double sn) {
+    for (int r = 0; r < rows; ++r) {
+      double* line = &q[r * cols];
+      const double x = line[p], z = line[s];
+      line[p] = x * c + z * sn;
+      line[s] = z * c - x * sn;
+    }
+  };
+  for (int k = n - 1; k >= 0; --k) {
+    for (int iteration = 0;; ++iteration) {
+      bool cancel = true;
+      int l = k;
+      for (; l >= 0; --l) {
+        if (l == 0 || std::abs(rv1[l]) <= eps * norm) {
+          cancel = false;
+          break;
+        }
+        if (std::abs(d[l - 1]) <= eps * norm) break;
+      }
+      if (cancel) {
+        double c = 0.0, s = 1.0;
+        for (int i = l; i <= k; ++i) {
+          const double f = s * rv1[i];
+          rv1[i] = c * rv1[i];
+          if (std::abs(f) <= eps * norm) break;
+          const double g = d[i];
+          const double h = std::hypot(f, g);
+          d[i] = h;
+          c = g / h;
+          s = -f / h;
+          rotate(u, m, n, l - 1, i, c, s);
+        }
+      }
+      double z = d[k];
+      if (l == k) {
+        if (z < 0.0) {
+          d[k] = -z;
+          for (int r = 0; r < n; ++r) v[r * n + k] = -v[r * n + k];
+        }
+        break;
+      }
+      if (iteration == kMaxIterations) {
+        throw std::runtime_error("Decomposition did not converge.");
+      }
+      double x = d[l], y = d[k - 1], g = rv1[k - 1], h = rv1[k];
+      double f = ((y - z) * (y + z) + (g - h) * (g + h)) / (2.0 * h * y);
+      g = std::hypot(f, 1.0);
+      f = ((x - z) * (x + z) + h * ((y / (f + std::copysign(g, f))) - h)) / x;
+      double c = 1.0, s = 1.0;
+      for (int j = l; j < k; ++j) {
+        const int i = j + 1;
+        g = rv1[i];
+        y = d[i];
+        h = s * g;
+        g = c * g;
+        z = std::hypot(f, h);
+        rv1[j] = z;
+        c = f / z;
+        s = h / z;
+        f = x * c + g * s;
+        g = g * c - x * s;
+        h = y * s;
+        y *= c;
+        rotate(v, n, n, j, i, c, s);
+        z = std::hypot(f, h);
+        d[j] = z;
+        if (z != 0.0) {
+          c = f / z;
+          s = h / z;
+        }
+        f = c * g + s * y;
+        x = c * y - s * g;
+        rotate(u, m, n, j, i, c, s);
+      }
+      rv1[l] = 0.0;
+      rv1[k] = f;
+      d[k] = x;
+    }
+  }
+}
+
+// Ортонормированный базис столбцов матрицы (тонкое QR через отражения)
+S21Matrix orthonormalColumns(const S21Matrix& matrix) {
+  const int m = matrix.getRows(), n = matrix.getCols();
+  Flat a = toFlat(matrix), tau(n, 0.0), sums(n);
+  for (int j = 0; j < n && j < m; ++j) {
+    tau[j] = householder(a, j * n + j, (j + 1) * n + j, m - j - 1, n);
+    const double diagonal = a[j * n + j];
+    a[j * n + j] = 1.0;
+    for (int c = j + 1; c < n; ++c) {
+      sums[c] = 0.0;
+      for (int r = j; r < m; ++r) sums[c] += a[r * n + j] * a[r * n + c];
+    }
+    for (int r = j; r < m; ++r) {
+      const double factor = tau[j] * a[r * n + j];
+      for (int c = j + 1; c < n; ++c) a[r * n + c] -= factor * sums[c];
+    }
+    a[j * n + j] = diagonal;
+  }
+  Flat q = accumulateReflectors(m, n, std::min(m, n), 0, tau,
+                                [&](int j, int r) { return a[r * n + j]; });
+  return fromFlat(q, m, n);
+}
+}  // namespace
+
+// Спектральное разложение симметричной матрицы
+// Блочное трёхдиагональное приведение + неявный QL-алгоритм
+S21EigenDecomposition S21Matrix::SymmetricEigen() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Matrix must be square to calculate eigenvalues.");
+  }
+  if (rows_ == 0) throw std::invalid_argument("Matrix is empty.");
+  if (!EqMatrix(Transpose(), 1e-12 * FrobeniusNorm(), 1e-9)) {
+    throw std::invalid_argument(
+        "Matrix must be symmetric to calculate eigenvalues.");
+  }
+  const int n = rows_;
+  Flat a = toFlat(*this), d, e, tau;
+  tridiagonalize(a, n, d, e, tau);
+  Flat z = accumulateReflectors(n, n, n - 1, 1, tau,
+                                [&](int j, int r) { return a[r * n + j]; });
+  tridiagonalQL(d, e, z, n);
+
+  std::vector<int> order(n);
+  for (int i = 0; i < n; ++i) order[i] = i;
+  std::sort(order.begin(), order.end(),
+            [&](int left, int right) { return d[left] < d[right]; });
+  S21EigenDecomposition result{S21Matrix(n, 1), S21Matrix(n, n)};
+  for (int j = 0; j < n; ++j) {
+    (*result.values.matrix_)[j][0] = d[order[j]];
+    for (int i = 0; i < n; ++i) {
+      (*result.vectors.matrix_)[i][j] = z[i * n + order[j]];
+    }
+  }
+  return result;
+}
+
+// Сингулярное разложение
+// Блочное двухдиагональное приведение + QR-алгоритм Голуба-Кахана.
+// Для m < n раскладывается A^T и множители меняются местами.
+S21SingularValueDecomposition S21Matrix::SVD() const {
+  if (rows_ < cols_) {
+    S21SingularValueDecomposition transposed = Transpose().SVD();
+    std::swap(transposed.u, transposed.v);
+    return transposed;
+  }
+  const int m = rows_, n = cols_;
+  if (n == 0) throw std::invalid_argument("Matrix is empty.");
+  Flat a = toFlat(*this), d, e, tauq, taup;
+  bidiagonalize(a, m, n, d, e, tauq, taup);
+  Flat u = accumulateReflectors(m, n, n, 0, tauq,
+                                [&](int j, int r) { return a[r * n + j]; });
+  Flat v = accumulateReflectors(n, n, n - 1, 1, taup,
+                                [&](int j, int r) { return a[j * n + r]; });
+  bidiagonalQR(d, e, u, v, m, n);
+
+  std::vector<int> order(n);
+  for (int i = 0; i < n; ++i) order[i] = i;
+  std::sort(order.begin(), order.end(),
+            [&](int left, int right) { return d[left] > d[right]; });
+  S21SingularValueDecomposition result{S21Matrix(m, n), S21Matrix(n, 1),
+                                       S21Matrix(n, n)};
+  for (int j = 0; j < n; ++j) {
+    (*result.values.matrix_)[j][0] = d[order[j]];
+    for (int i = 0; i < m; ++i) {
+      (*result.u.matrix_)[i][j] = u[i * n + order[j]];
+    }
+    for (int i = 0; i < n; ++i) {
+      (*result.v.matrix_)[i][j] = v[i * n + order[j]];
+    }
+  }
+  return result;
+}
+
+// Усечённое рандомизированное SVD (схема Халко-Мартинссона-Троппа):
+// образ случайной матрицы из rank + oversampling столбцов уточняется
+// степенными итерациями, затем раскладывается малая проекция Q^T * A.
+// Все тяжёлые шаги - умножения матриц.
+S21SingularValueDecomposition S21Matrix::TruncatedSVD(
+    int rank, int oversampling, int power_iterations) const {
+  const int smaller = std::min(rows_, cols_);
+  if (rank < 1 || rank > smaller || oversampling < 0 || power_iterations < 0) {
+    throw std::invalid_argument("Invalid truncated SVD parameters.");
+  }
+  S21SingularValueDecomposition result;
+  const int width = std::min(rank + oversampling, smaller);
+  if (width == smaller) {
+    result = SVD();
+  } else {
+    std::mt19937_64 generator(rows_ * 1000003ull + cols_);
+    std::normal_distribution<double> normal;
+    S21Matrix omega(cols_, width);
+    for (auto& row : *omega.matrix_) {
+      for (auto& value : row) value = normal(generator);
+    }
+    S21Matrix q = orthonormalColumns(*this * omega);
+    for (int i = 0; i < power_iterations; ++i) {
+      S21Matrix z = orthonormalColumns(Transpose() * q);
+      q = orthonormalColumns(*this * z);
+    }
+    result = (q.Transpose() * *this).SVD();
+    result.u = q * result.u;
+  }
+  result.u.SetCols(rank);
+  result.v.SetCols(rank);
+  result.values.SetRows(rank);
+  return result;
+}
@@ -0,0 +1,232 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include "s21_matrix.h"
+#include "s21_thread_pool.h"
+
+namespace {
+// Минимальный размер части текста, разбираемой одним потоком
+constexpr size_t kMinChunkBytes = 1 << 16;
+// Примерный объём текста, форматируемого за один проход перед записью
+constexpr size_t kWriteBatchBytes = 8 << 20;
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+bool isBlank(const char* begin, const char* end) {
+  while (begin != end && isSpace(*begin)) ++begin;
+  return begin == end;
+}
+
+// Конец строки, начинающейся с begin (позиция '\n' или end)
+const char* lineEnd(const char* begin, const char* end) {
+  const void* found = std::memchr(begin, '\n', end - begin);
+  return found ? static_cast<const char*>(found) : end;
+}
+
+// Разбор значений одной строки. Пробелы и табуляции вокруг значений
+// пропускаются (кроме совпадающих с разделителем), при разделителе ' '
+// значения разделяет любая их серия. Ведущий '+' допускается только
+// перед самим числом. Значения пишутся в out (если он задан, не больше
+// limit штук). Возвращает число значений или -1 при ошибке формата.
+int parseLine(const char* p, const char* end, char delimiter, double* out,
+              int limit) {
+  const auto skip = [delimiter](char c) {
+    return isSpace(c) && (delimiter == ' ' || c != delimiter);
+  };
+  int count = 0;
+  while (true) {
+    while (p != end && skip(*p)) ++p;
+    if (end - p > 1 && *p == '+' && p[1] != '+' && p[1] != '-') ++p;
+    double value = 0.0;
+    const std::from_chars_result parsed = std::from_chars(p, end, value);
+    if (parsed.ec != std::errc()) return -1;
+    if (out) {
+      if (count == limit) return -1;
+      out[count] = value;
+    }
+    ++count;
+    p = parsed.ptr;
+    while (p != end && skip(*p)) ++p;
+    if (p == end) return count;
+    if (delimiter != ' ') {
+      if (*p != delimiter) return -1;
+      ++p;
+    }
+  }
+}
+
+// Границы частей текста для параллельного разбора: каждая часть, кроме
+// первой, начинается сразу после перевода строки
+std::vector<const char*> splitChunks(const char* begin, const char* end) {
+  const size_t size = end - begin;
+  const size_t parts = std::max<size_t>(
+      1, std::min<size_t>(size / kMinChunkBytes,
+                          4 * S21ThreadPool::Instance().Size()));
+  std::vector<const char*> bounds{begin};
+  for (size_t t = 1; t < parts; ++t) {
+    const char* p = std::max(begin + size * t / parts, bounds.back());
+    p = lineEnd(p, end);
+    bounds.push_back(p == end ? end : p + 1);
+  }
+  bounds.push_back(end);
+  return bounds;
+}
+
+// Отображение файла в память только для чтения
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open file: " + path);
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+      size_ = static_cast<size_t>(info.st_size);
+      void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        close(fd);
+        throw std::runtime_error("Cannot map file: " + path);
+      }
+      madvise(data, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(data);
+    }
+    close(fd);
+  }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() {
+    if (data_) munmap(const_cast<char*>(data_), size_);
+  }
+
+  std::string_view Text() const { return std::string_view(data_, size_); }
+
+ private:
+  const char* data_;
+  size_t size_;
+};
+}  // namespace
+
+// Чтение матрицы из CSV-файла (или файла со значениями через пробел при
+// delimiter ' '). Файл отображается в память или читается целиком.
+S21Matrix S21Matrix::FromCSV(const std::string& path, char delimiter,
+                             S21FileMode mode) {
+  if (mode == S21FileMode::kMemoryMap) {
+    MappedFile file(path);
+    return ParseCSV(file.Text(), delimiter);
+  }
+  std::ifstream input(path, std::ios::binary | std::ios::ate);
+  if (!input) throw std::runtime_error("Cannot open file: " + path);
+  std::string text(static_cast<size_t>(input.tellg()), '\0');
+  input.seekg(0);
+  input.read(text.data(), static_cast<std::streamsize>(text.size()));
+  return ParseCSV(text, delimiter);
+}
+
+// Разбор текста в два параллельных прохода по частям, выровненным по
+// строкам: первый считает непустые строки каждой части, второй разбирает
+// значения через std::from_chars сразу в строки хранилища, начиная с
+// номера, полученного префиксной суммой. Число столбцов задаёт первая
+// непустая строка.
+S21Matrix S21Matrix::ParseCSV(std::string_view text, char delimiter) {
+  const char* begin = text.data();
+  const char* end = begin + text.size();
+  const char* first = begin;
+  while (first != end && isBlank(first, lineEnd(first, end))) {
+    first = lineEnd(first, end);
+    if (first != end) ++first;
+  }
+  if (first == end) throw std::invalid_argument("CSV input contains no rows.");
+  const int cols =
+      parseLine(first, lineEnd(first, end), delimiter, nullptr, 0);
+  if (cols < 1) throw std::invalid_argument("Invalid number in CSV input.");
+
+  const std::vector<const char*> bounds = splitChunks(begin, end);
+  const int chunks = static_cast<int>(bounds.size()) - 1;
+  std::vector<long long> starts(chunks + 1, 0);
+  const long long cost = static_cast<long long>(text.size() / chunks);
+  parallelFor(0, chunks, cost, [&](int from, int to) {
+    for (int t = from; t < to; ++t) {
+      long long lines = 0;
+      for (const char* p = bounds[t]; p < bounds[t + 1];) {
+        const char* stop = lineEnd(p, bounds[t + 1]);
+        if (!isBlank(p, stop)) ++lines;
+        p = stop + (stop != bounds[t + 1]);
+      }
+      starts[t + 1] = lines;
+    }
+  });
+  for (int t = 0; t < chunks; ++t) starts[t + 1] += starts[t];
+  if (starts[chunks] > std::numeric_limits<int>::max()) {
+    throw std::invalid_argument("CSV input has too many rows.");
+  }
+
+  S21Matrix result(static_cast<int>(starts[chunks]), cols);
+  Storage& rows = *result.matrix_;
+  parallelFor(0, chunks, cost, [&](int from, int to) {
+    for (int t = from; t < to; ++t) {
+      long long row = starts[t];
+      for (const char* p = bounds[t]; p < bounds[t + 1];) {
+        const char* stop = lineEnd(p, bounds[t + 1]);
+        if (!isBlank(p, stop)) {
+          const int count =
+              parseLine(p, stop, delimiter, rows[row].data(), cols);
+          if (count < 0) {
+            throw std::invalid_argument("Invalid number in CSV input.");
+          }
+          if (count != cols) {
+            throw std::invalid_argument("CSV rows have different lengths.");
+          }
+          ++row;
+        }
+        p = stop + (stop != bounds[t + 1]);
+      }
+    }
+  });
+  return result;
+}
+
+// Запись матрицы в CSV-файл
+void S21Matrix::ToCSV(const std::string& path, char delimiter) const {
+  std::ofstream output(path, std::ios::binary);
+  if (!output) throw std::runtime_error("Cannot open file: " + path);
+  ToCSV(output, delimiter);
+  if (!output) throw std::runtime_error("Cannot write file: " + path);
+}
+
+// Запись матрицы в поток. Строки форматируются параллельно пачками
+// примерно по kWriteBatchBytes через std::to_chars (кратчайшая запись,
+// читаемая обратно без потери точности) и выводятся по порядку.
+void S21Matrix::ToCSV(std::ostream& output, char delimiter) const {
+  if (!matrix_) return;
+  const S21Matrix source = rowMajor();
+  const Storage& rows = *source.matrix_;
+  const int cols = cols_;
+  const int batch = static_cast<int>(std::max<size_t>(
+      1, kWriteBatchBytes / (static_cast<size_t>(cols) * 24)));
+  std::vector<std::string> lines(std::min(batch, rows_));
+  for (int start = 0; start < rows_; start += batch) {
+    const int count = std::min(batch, rows_ - start);
+    parallelFor(0, count, cols, [&](int from, int to) {
+      char buffer[32];
+      for (int r = from; r < to; ++r) {
+        std::string& line = lines[r];
+        line.clear();
+        const double* row = rows[start + r].data();
+        for (int j = 0; j < cols; ++j) {
+          if (j > 0) line.push_back(delimiter);
+          const std::to_chars_result written =
+              std::to_chars(buffer, buffer + sizeof(buffer), row[j]);
+          line.append(buffer, written.ptr);
+        }
+        line.push_back('\n');
+      }
+    });
+    for (int r = 0; r < count; ++r) output << lines[r];
+  }
+}
@@ -0,0 +1,120 @@
+#include <cmath>
+
+#include "s21_matrix.h"
+
+namespace {
+// Степень числителя и знаменателя аппроксимации Паде для экспоненты
+constexpr int kPadeDegree = 6;
+}  // namespace
+
+// Возведение в целую степень двоичным методом: не больше 2 * log2(|k|)
+// умножений. Степени основания и накопленный результат хранятся в заранее
+// выделенных буферах, которые после каждого умножения меняются местами
+// с рабочим буфером, так что новые матрицы в цикле не выделяются.
+// Отрицательная степень - степень обратной матрицы.
+S21Matrix S21Matrix::Pow(int k) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to calculate power.");
+  }
+  const int n = rows_;
+  unsigned long long exponent =
+      k < 0 ? static_cast<unsigned long long>(-static_cast<long long>(k))
+            : static_cast<unsigned long long>(k);
+  S21Matrix base = k < 0 ? InverseMatrix() : *this;
+  base.Materialize();
+  S21Matrix result(n, n), scratch(n, n);
+  bool empty = true;
+  while (exponent > 0) {
+    if (exponent & 1) {
+      if (empty) {
+        *result.matrix_ = *base.matrix_;
+        empty = false;
+      } else {
+        multiplyInto(*result.matrix_, *base.matrix_, *scratch.matrix_, n);
+        std::swap(result.matrix_, scratch.matrix_);
+      }
+    }
+    exponent >>= 1;
+    if (exponent > 0) {
+      multiplyInto(*base.matrix_, *base.matrix_, *scratch.matrix_, n);
+      std::swap(base.matrix_, scratch.matrix_);
+    }
+  }
+  if (empty) {
+    for (int i = 0; i < n; ++i) (*result.matrix_)[i][i] = 1.0;
+  }
+  return result;
+}
+
+// Матричная экспонента масштабированием и возведением в квадрат:
+// exp(A) = (exp(A / 2^s))^(2^s), где s выбрано так, что
+// ||A / 2^s||_inf <= 1/2, а exp(A / 2^s) приближается диагональной
+// аппроксимацией Паде степени 6: D^-1 * N, N = sum c_j X^j,
+// D = sum (-1)^j c_j X^j. Для такой нормы погрешность аппроксимации
+// меньше машинного эпсилон (Golub, Van Loan, алгоритм 11.3.1).
+S21Matrix S21Matrix::Exp() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument(
+        "Matrix must be square to calculate exponential.");
+  }
+  const double norm = InfNorm();
+  if (!std::isfinite(norm)) {
+    throw std::invalid_argument("Matrix contains non-finite values.");
+  }
+  const int n = rows_;
+  int exponent = 0;
+  std::frexp(norm, &exponent);
+  const int squarings = std::max(0, exponent + 1);
+
+  S21Matrix a = *this * std::ldexp(1.0, -squarings);
+  a.Materialize();
+  S21Matrix power = a, scratch(n, n);
+  S21Matrix numerator(n, n), denominator(n, n);
+  Storage& num = *numerator.matrix_;
+  Storage& den = *denominator.matrix_;
+  double c = 0.5;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      const double term = c * (*a.matrix_)[i][j] + (i == j ? 1.0 : 0.0);
+      num[i][j] = term;
+      den[i][j] = 2.0 * (i == j ? 1.0 : 0.0) - term;
+    }
+  }
+  for (int q = 2; q <= kPadeDegree; ++q) {
+    c *= static_cast<double>(kPadeDegree - q + 1) /
+         (q * (2 * kPadeDegree - q + 1));
+    multiplyInto(*a.matrix_, *power.matrix_, *scratch.matrix_, n);
+    std::swap(power.matrix_, scratch.matrix_);
+    const Storage& x = *power.matrix_;
+    const double sign = q % 2 ? -c : c;
+    parallelFor(0, n, n, [&](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        for (int j = 0; j < n; ++j) {
+          num[i][j] += c * x[i][j];
+          den[i][j] += sign * x[i][j];
+        }
+      }
+    });
+  }
+
+  LUDecomposition lu = denominator.decomposeLU();
+  if (lu.rank < n) {
+    throw std::runtime_error("Pade denominator is singular.");
+  }
+  S21Matrix result(n, n);
+  luSolve(lu, num, *result.matrix_, n);
+  for (int s = 0; s < squarings; ++s) {
+    multiplyInto(*result.matrix_, *result.matrix_, *scratch.matrix_, n);
+    std::swap(result.matrix_, scratch.matrix_);
+  }
+  return result;
+}
+
+// Произведение квадратных построчных матриц c = a * b в готовый буфер c
+void S21Matrix::multiplyInto(const Storage& a, const Storage& b, Storage& c,
+                             int size) {
+  parallelFor(0, size, size, [&c](int from, int to) {
+    for (int i = from; i < to; ++i) std::fill(c[i].begin(), c[i].end(), 0.0);
+  });
+  multiplyKernel(a, false, b, false, c, size, size, size);
+}
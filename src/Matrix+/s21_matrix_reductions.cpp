@@ -0,0 +1,254 @@
+#include "s21_matrix.h"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace {
+// Число строк в блоке свёртки. Частичные результаты считаются по блокам
+// фиксированного размера и объединяются по порядку блоков, поэтому
+// результат не зависит ни от числа потоков, ни от порядка их завершения.
+constexpr int kReduceBlockRows = 64;
+
+// Свёртка строки с четырьмя независимыми аккумуляторами: цепочки
+// зависимостей короче, и компилятор может развернуть цикл в векторные
+// инструкции. step добавляет элемент к аккумулятору, merge объединяет
+// аккумуляторы между собой.
+template <class Step, class Merge>
+double foldRow(const double* row, int count, double init, Step step,
+               Merge merge) {
+  double acc0 = init, acc1 = init, acc2 = init, acc3 = init;
+  int j = 0;
+  for (; j + 4 <= count; j += 4) {
+    acc0 = step(acc0, row[j]);
+    acc1 = step(acc1, row[j + 1]);
+    acc2 = step(acc2, row[j + 2]);
+    acc3 = step(acc3, row[j + 3]);
+  }
+  for (; j < count; ++j) acc0 = step(acc0, row[j]);
+  return merge(merge(acc0, acc1), merge(acc2, acc3));
+}
+
+double plus(double left, double right) { return left + right; }
+double absPlus(double acc, double value) { return acc + std::abs(value); }
+double squarePlus(double acc, double value) { return acc + value * value; }
+double minimum(double left, double right) { return std::min(left, right); }
+double maximum(double left, double right) { return std::max(left, right); }
+}  // namespace
+
+// Проверка равенства с допуском |a - b| <= abs + rel * max(|a|, |b|)
+// Строки проверяются параллельно, при первом расхождении проверка
+// остальных строк прекращается.
+bool S21Matrix::EqMatrix(const S21Matrix& other, double abs_tolerance,
+                         double rel_tolerance) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) return false;
+  if (!matrix_) return true;
+  const Storage& a = *matrix_;
+  const Storage& b = *other.matrix_;
+  const bool same_layout = transposed_ == other.transposed_;
+  const int rows = transposed_ ? cols_ : rows_;
+  const int cols = transposed_ ? rows_ : cols_;
+  std::atomic<bool> equal(true);
+  parallelFor(0, rows, cols, [&](int from, int to) {
+    for (int i = from; i < to && equal; ++i) {
+      const double* row = a[i].data();
+      for (int j = 0; j < cols; ++j) {
+        const double value = same_layout ? b[i][j] : b[j][i];
+        const double scale = std::max(std::abs(row[j]), std::abs(value));
+        if (!(std::abs(row[j] - value) <= abs_tolerance +
+                                              rel_tolerance * scale)) {
+          equal = false;
+          break;
+        }
+      }
+    }
+  });
+  return equal;
+}
+
+// След квадратной матрицы
+double S21Matrix::Trace() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square to calculate trace.");
+  }
+  double trace = 0.0;
+  for (int i = 0; i < rows_; ++i) trace += (*matrix_)[i][i];
+  return trace;
+}
+
+// Норма Фробениуса
+double S21Matrix::FrobeniusNorm() const {
+  const double squares = reduceRows(
+      [this](int i) {
+        const Row& row = (*matrix_)[i];
+        return foldRow(row.data(), static_cast<int>(row.size()), 0.0,
+                       squarePlus, plus);
+      },
+      plus, 0.0);
+  return std::sqrt(squares);
+}
+
+// 1-норма: максимальная сумма модулей по столбцам
+double S21Matrix::OneNorm() const {
+  if (rows_ == 0) return 0.0;
+  std::vector<double> sums = transposed_ ? physicalRowSums(true)
+                                         : physicalColumnSums(true);
+  return foldRow(sums.data(), static_cast<int>(sums.size()), 0.0, maximum,
+                 maximum);
+}
+
+// Бесконечная норма: максимальная сумма модулей по строкам
+double S21Matrix::InfNorm() const {
+  if (rows_ == 0) return 0.0;
+  std::vector<double> sums = transposed_ ? physicalColumnSums(true)
+                                         : physicalRowSums(true);
+  return foldRow(sums.data(), static_cast<int>(sums.size()), 0.0, maximum,
+                 maximum);
+}
+
+// Минимальный элемент
+double S21Matrix::Min() const {
+  if (rows_ == 0) throw std::invalid_argument("Matrix is empty.");
+  const double inf = std::numeric_limits<double>::infinity();
+  return reduceRows(
+      [this, inf](int i) {
+        const Row& row = (*matrix_)[i];
+        return foldRow(row.data(), static_cast<int>(row.size()), inf, minimum,
+                       minimum);
+      },
+      minimum, inf);
+}
+
+// Максимальный элемент
+double S21Matrix::Max() const {
+  if (rows_ == 0) throw std::invalid_argument("Matrix is empty.");
+  const double inf = -std::numeric_limits<double>::infinity();
+  return reduceRows(
+      [this, inf](int i) {
+        const Row& row = (*matrix_)[i];
+        return foldRow(row.data(), static_cast<int>(row.size()), inf, maximum,
+                       maximum);
+      },
+      maximum, inf);
+}
+
+// Максимальный модуль разности элементов двух матриц
+double S21Matrix::MaxAbsDiff(const S21Matrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Matrices dimensions are not equal.");
+  }
+  if (!matrix_) return 0.0;
+  const Storage& a = *matrix_;
+  const Storage& b = *other.matrix_;
+  const bool same_layout = transposed_ == other.transposed_;
+  return reduceRows(
+      [&](int i) {
+        const Row& row = a[i];
+        const int cols = static_cast<int>(row.size());
+        double diff = 0.0;
+        if (same_layout) {
+          const double* other_row = b[i].data();
+          for (int j = 0; j < cols; ++j) {
+            diff = std::max(diff, std::abs(row[j] - other_row[j]));
+          }
+        } else {
+          for (int j = 0; j < cols; ++j) {
+            diff = std::max(diff, std::abs(row[j] - b[j][i]));
+          }
+        }
+        return diff;
+      },
+      maximum, 0.0);
+}
+
+// Суммы по строкам в виде столбца rows x 1
+S21Matrix S21Matrix::RowSums() const {
+  S21Matrix result(rows_, 1);
+  std::vector<double> sums = transposed_ ? physicalColumnSums(false)
+                                         : physicalRowSums(false);
+  for (int i = 0; i < rows_; ++i) (*result.matrix_)[i][0] = sums[i];
+  return result;
+}
+
+// Суммы по столбцам в виде строки 1 x cols
+S21Matrix S21Matrix::ColSums() const {
+  S21Matrix result(1, cols_);
+  const std::vector<double> sums = transposed_ ? physicalRowSums(false)
+                                                : physicalColumnSums(false);
+  (*result.matrix_)[0].assign(sums.begin(), sums.end());
+  return result;
+}
+
+// Приватные вспомогательные функции
+
+// Параллельная свёртка по строкам хранилища: row_value сворачивает
+// одну строку, combine объединяет результаты строк и блоков
+double S21Matrix::reduceRows(
+    const std::function<double(int)>& row_value,
+    const std::function<double(double, double)>& combine, double init) const {
+  if (!matrix_) return init;
+  const Storage& storage = *matrix_;
+  const int rows = static_cast<int>(storage.size());
+  const int cols = rows > 0 ? static_cast<int>(storage[0].size()) : 0;
+  const int blocks = (rows + kReduceBlockRows - 1) / kReduceBlockRows;
+  std::vector<double> partials(blocks, init);
+  parallelFor(0, blocks, static_cast<long long>(kReduceBlockRows) * cols,
+              [&](int from, int to) {
+                for (int b = from; b < to; ++b) {
+                  const int last = std::min(rows, (b + 1) * kReduceBlockRows);
+                  for (int i = b * kReduceBlockRows; i < last; ++i) {
+                    partials[b] = combine(partials[b], row_value(i));
+                  }
+                }
+              });
+  double result = init;
+  for (double partial : partials) result = combine(result, partial);
+  return result;
+}
+
+// Суммы (или суммы модулей) строк хранилища
+std::vector<double> S21Matrix::physicalRowSums(bool absolute) const {
+  const Storage& storage = *matrix_;
+  std::vector<double> sums(storage.size());
+  const int cols = static_cast<int>(storage[0].size());
+  parallelFor(0, static_cast<int>(storage.size()), cols, [&](int from, int to) {
+    for (int i = from; i < to; ++i) {
+      sums[i] = absolute ? foldRow(storage[i].data(), cols, 0.0, absPlus, plus)
+                         : foldRow(storage[i].data(), cols, 0.0, plus, plus);
+    }
+  });
+  return sums;
+}
+
+// Суммы (или суммы модулей) столбцов хранилища: каждый блок строк
+// накапливает свой вектор сумм, затем векторы складываются по порядку
+std::vector<double> S21Matrix::physicalColumnSums(bool absolute) const {
+  const Storage& storage = *matrix_;
+  const int rows = static_cast<int>(storage.size());
+  const int cols = static_cast<int>(storage[0].size());
+  const int blocks = (rows + kReduceBlockRows - 1) / kReduceBlockRows;
+  std::vector<std::vector<double>> partials(blocks);
+  parallelFor(0, blocks, static_cast<long long>(kReduceBlockRows) * cols,
+              [&](int from, int to) {
+                for (int b = from; b < to; ++b) {
+                  std::vector<double>& partial = partials[b];
+                  partial.assign(cols, 0.0);
+                  const int last = std::min(rows, (b + 1) * kReduceBlockRows);
+                  for (int i = b * kReduceBlockRows; i < last; ++i) {
+                    const double* row = storage[i].data();
+                    if (absolute) {
+                      for (int j = 0; j < cols; ++j) {
+                        partial[j] += std::abs(row[j]);
+                      }
+                    } else {
+                      for (int j = 0; j < cols; ++j) partial[j] += row[j];
+                    }
+                  }
+                }
+              });
+  std::vector<double> sums(cols, 0.0);
+  for (const auto& partial : partials) {
+    for (int j = 0; j < cols; ++j) sums[j] += partial[j];
+  }
+  return sums;
+}
@@ -0,0 +1,203 @@
+#include "s21_numa.h"
+
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Размер маски узлов для get_mempolicy: не меньше числа узлов ядра
+constexpr unsigned long kBitsPerWord = sizeof(unsigned long) * 8;
+constexpr unsigned long kMaskWords = 1024 / kBitsPerWord;
+
+// Разбор списков вида "0-3,8,10-11" из /sys
+std::vector<int> parseList(const std::string& text) {
+  std::vector<int> result;
+  std::stringstream stream(text);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty() || range == "\n") continue;
+    const size_t dash = range.find('-');
+    const int first = std::stoi(range.substr(0, dash));
+    const int last =
+        dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int i = first; i <= last; ++i) result.push_back(i);
+  }
+  return result;
+}
+
+std::string readLine(const std::string& path) {
+  std::ifstream input(path);
+  std::string line;
+  std::getline(input, line);
+  return line;
+}
+
+struct Topology {
+  std::vector<int> nodes;
+  std::vector<std::vector<int>> cpus;
+
+  Topology() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    const bool known = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+    for (int node :
+         parseList(readLine("/sys/devices/system/node/online"))) {
+      std::vector<int> node_cpus;
+      for (int cpu : parseList(readLine("/sys/devices/system/node/node" +
+                                        std::to_string(node) + "/cpulist"))) {
+        if (!known || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed))) {
+          node_cpus.push_back(cpu);
+        }
+      }
+      if (node_cpus.empty()) continue;
+      nodes.push_back(node);
+      cpus.push_back(std::move(node_cpus));
+    }
+    if (nodes.empty()) {
+      nodes.push_back(0);
+      cpus.emplace_back();
+      for (int cpu = 0; known && cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed)) cpus[0].push_back(cpu);
+      }
+    }
+  }
+};
+
+const Topology& topology() {
+  static const Topology instance;
+  return instance;
+}
+}  // namespace
+
+// Число узлов с доступными процессору процессорами
+int S21Numa::NodeCount() { return static_cast<int>(topology().nodes.size()); }
+
+// Процессоры узла (узлы нумеруются подряд с нуля)
+const std::vector<int>& S21Numa::NodeCpus(int node) {
+  if (node < 0 || node >= NodeCount()) {
+    throw std::out_of_range("NUMA node out of range.");
+  }
+  return topology().cpus[node];
+}
+
+// Процессоры всех узлов подряд
+std::vector<int> S21Numa::CpusByNode() {
+  std::vector<int> result;
+  for (const auto& cpus : topology().cpus) {
+    result.insert(result.end(), cpus.begin(), cpus.end());
+  }
+  return result;
+}
+
+// Узел процессора, -1 если процессор недоступен
+int S21Numa::NodeOfCpu(int cpu) {
+  for (int node = 0; node < NodeCount(); ++node) {
+    for (int node_cpu : topology().cpus[node]) {
+      if (node_cpu == cpu) return node;
+    }
+  }
+  return -1;
+}
+
+// Закрепление вызывающего потока за процессором
+bool S21Numa::PinCurrentThread(int cpu) {
+  if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// Текущая политика выделения страниц вызывающего потока
+S21Numa::ThreadPolicy S21Numa::GetThreadPolicy() {
+  ThreadPolicy result;
+  result.nodes.assign(kMaskWords, 0);
+  result.valid =
+      syscall(SYS_get_mempolicy, &result.mode, result.nodes.data(),
+              kMaskWords * kBitsPerWord, nullptr, 0) == 0;
+  return result;
+}
+
+// Режим и маска узлов ядра для политики kBind (узел node) или
+// kInterleave (все узлы). false, если узел не помещается в маску.
+bool S21Numa::policyMask(S21MemoryPolicy policy, int node, int& mode,
+                         unsigned long& mask) {
+  mask = 0;
+  if (policy == S21MemoryPolicy::kBind) {
+    NodeCpus(node);
+    const int system_node = topology().nodes[node];
+    if (system_node >= static_cast<int>(sizeof(mask) * 8)) return false;
+    mask = 1ul << system_node;
+  } else {
+    for (int system_node : topology().nodes) {
+      if (system_node < static_cast<int>(sizeof(mask) * 8)) {
+        mask |= 1ul << system_node;
+      }
+    }
+  }
+  mode = policy == S21MemoryPolicy::kBind ? MPOL_BIND : MPOL_INTERLEAVE;
+  return true;
+}
+
+// Установка политики выделения страниц для вызывающего потока.
+// kFirstTouch соответствует политике по умолчанию (память узла того
+// потока, который первым записал в страницу).
+bool S21Numa::SetThreadPolicy(S21MemoryPolicy policy, int node) {
+  if (policy == S21MemoryPolicy::kFirstTouch) {
+    return syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0) == 0;
+  }
+  int mode = 0;
+  unsigned long mask = 0;
+  if (!policyMask(policy, node, mode, mask)) return false;
+  return syscall(SYS_set_mempolicy, mode, &mask, sizeof(mask) * 8 + 1) == 0;
+}
+
+// Политика размещения для отображения [address, address + bytes)
+// (mbind). Она действует на страницы, в которые ещё не записывали, кем
+// бы они ни были тронуты. kFirstTouch возвращает политику по умолчанию.
+bool S21Numa::BindMemory(void* address, std::size_t bytes,
+                         S21MemoryPolicy policy, int node) {
+  if (policy == S21MemoryPolicy::kFirstTouch) {
+    return syscall(SYS_mbind, address, bytes, MPOL_DEFAULT, nullptr, 0, 0) ==
+           0;
+  }
+  int mode = 0;
+  unsigned long mask = 0;
+  if (!policyMask(policy, node, mode, mask)) return false;
+  return syscall(SYS_mbind, address, bytes, mode, &mask, sizeof(mask) * 8 + 1,
+                 0) == 0;
+}
+
+// Узел, на котором размещена страница с адресом address (нумерация
+// NodeCpus), -1 если страница не размещена или узел неизвестен
+int S21Numa::NodeOfAddress(const void* address) {
+  int system_node = -1;
+  if (syscall(SYS_get_mempolicy, &system_node, nullptr, 0, address,
+              MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+    return -1;
+  }
+  for (int node = 0; node < NodeCount(); ++node) {
+    if (topology().nodes[node] == system_node) return node;
+  }
+  return -1;
+}
+
+// Возврат к политике, сохранённой GetThreadPolicy (режим вместе с
+// флагами, например MPOL_F_STATIC_NODES). Если сохранить её не удалось,
+// устанавливается политика по умолчанию.
+void S21Numa::RestoreThreadPolicy(const ThreadPolicy& saved) {
+  if (!saved.valid || saved.mode == MPOL_DEFAULT) {
+    syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+    return;
+  }
+  // set_mempolicy учитывает maxnode - 1 бит маски
+  syscall(SYS_set_mempolicy, saved.mode, saved.nodes.data(),
+          saved.nodes.size() * kBitsPerWord + 1);
+}
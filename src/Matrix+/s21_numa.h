@@ -0,0 +1,50 @@
+#ifndef S21_NUMA_H
+#define S21_NUMA_H
+
+#include <cstddef>
+#include <vector>
+
+// Политика размещения строк матрицы по узлам NUMA
+enum class S21MemoryPolicy {
+  kFirstTouch,  // строки создаются рабочими потоками, которые их обрабатывают
+  kInterleave,  // страницы чередуются по всем узлам
+  kBind         // все страницы на заданном узле
+};
+
+// Топология NUMA и управление размещением памяти и потоков (Linux).
+// На системах без NUMA все функции деградируют до одного узла и
+// ничего не меняют.
+class S21Numa {
+ public:
+  static int NodeCount();
+  // Доступные процессу процессоры узла
+  static const std::vector<int>& NodeCpus(int node);
+  // Процессоры, упорядоченные по узлам: потоки, закреплённые за
+  // соседними номерами, оказываются на одном узле
+  static std::vector<int> CpusByNode();
+  static int NodeOfCpu(int cpu);
+
+  // Сохранённая политика выделения памяти потока (режим и маска узлов
+  // в формате get_mempolicy)
+  struct ThreadPolicy {
+    int mode = 0;
+    std::vector<unsigned long> nodes;
+    bool valid = false;
+  };
+
+  static bool PinCurrentThread(int cpu);
+  // Политика выделения памяти для текущего потока
+  static ThreadPolicy GetThreadPolicy();
+  static bool SetThreadPolicy(S21MemoryPolicy policy, int node);
+  static void RestoreThreadPolicy(const ThreadPolicy& saved);
+  // Политика выделения памяти для диапазона адресов
+  static bool BindMemory(void* address, std::size_t bytes,
+                         S21MemoryPolicy policy, int node);
+  static int NodeOfAddress(const void* address);
+
+ private:
+  static bool policyMask(S21MemoryPolicy policy, int node, int& mode,
+                         unsigned long& mask);
+};
+
+#endif
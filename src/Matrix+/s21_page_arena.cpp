@@ -0,0 +1,226 @@
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "s21_aligned_allocator.h"
+
+namespace {
+constexpr std::size_t kHugePageSize = 2u << 20;
+constexpr std::size_t kPageSize = 4096;
+// Наибольший объём отображений, хранимых в кэше процесса
+constexpr std::size_t kMaxCachedBytes = 256u << 20;
+
+std::size_t roundUp(std::size_t value, std::size_t step) {
+  return (value + step - 1) / step * step;
+}
+
+// Включены ли прозрачные huge-страницы: режим "always" или "madvise"
+// в /sys/kernel/mm/transparent_hugepage/enabled (выбранный - в скобках)
+bool transparentHugeEnabled() {
+  static const bool enabled = [] {
+    std::ifstream input("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string mode;
+    std::getline(input, mode);
+    return mode.find("[always]") != std::string::npos ||
+           mode.find("[madvise]") != std::string::npos;
+  }();
+  return enabled;
+}
+}  // namespace
+
+// Освобождённые отображения всех областей процесса
+struct S21PageArena::Cache {
+  std::mutex mutex;
+  std::vector<Chunk> chunks;
+  std::size_t bytes = 0;
+};
+
+// Пустая область, отображения создаются при первом выделении
+S21PageArena::S21PageArena(S21PagePolicy policy, S21MemoryPolicy memory,
+                           int node)
+    : cursor_(nullptr),
+      end_(nullptr),
+      policy_(policy),
+      memory_(memory),
+      node_(memory == S21MemoryPolicy::kBind ? node : 0),
+      huge_(false) {}
+
+// Возврат всех отображений в кэш
+S21PageArena::~S21PageArena() {
+  for (const Chunk& chunk : chunks_) release(chunk);
+}
+
+// Заранее отображённый участок, в который поместятся count выделений
+// по bytes байт
+void S21PageArena::Reserve(std::size_t count, std::size_t bytes) {
+  bytes = count * blockSize(bytes);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (static_cast<std::size_t>(end_ - cursor_) < bytes) mapChunk(bytes);
+}
+
+// Выделение выровненного участка из текущего отображения
+void* S21PageArena::Allocate(std::size_t bytes) {
+  bytes = blockSize(bytes);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (static_cast<std::size_t>(end_ - cursor_) < bytes) mapChunk(bytes);
+  void* result = cursor_;
+  cursor_ += bytes;
+  chunks_.back().used += bytes;
+  return result;
+}
+
+// Освобождение участка. Опустевшее текущее отображение заполняется
+// заново с начала, остальные опустевшие уходят в кэш.
+void S21PageArena::Deallocate(void* pointer, std::size_t bytes) noexcept {
+  bytes = blockSize(bytes);
+  char* address = static_cast<char*>(pointer);
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (std::size_t i = 0; i < chunks_.size(); ++i) {
+    Chunk& chunk = chunks_[i];
+    if (address < chunk.base || address >= chunk.base + chunk.size) continue;
+    chunk.used -= bytes;
+    if (chunk.used > 0) return;
+    if (i + 1 == chunks_.size()) {
+      cursor_ = chunk.base;
+    } else {
+      release(chunk);
+      chunks_.erase(chunks_.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    return;
+  }
+}
+
+// Политика страниц
+S21PagePolicy S21PageArena::Policy() const noexcept { return policy_; }
+
+// Используются ли huge-страницы
+bool S21PageArena::HugePages() const noexcept { return huge_; }
+
+// Суммарный размер отображений
+std::size_t S21PageArena::MappedBytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::size_t total = 0;
+  for (const Chunk& chunk : chunks_) total += chunk.size;
+  return total;
+}
+
+// Размер участка под bytes байт: кратен kS21Alignment, а участки
+// длиной в целое число страниц удлиняются на строку кэша. Иначе строки
+// матрицы, идущие подряд, начинаются с одинаковым смещением в странице,
+// и проход по столбцу попадает в одно множество кэша.
+std::size_t S21PageArena::blockSize(std::size_t bytes) noexcept {
+  bytes = roundUp(std::max<std::size_t>(bytes, 1), kS21Alignment);
+  return bytes % kPageSize == 0 ? bytes + kS21Alignment : bytes;
+}
+
+// Общий кэш. Он не разрушается при выходе, чтобы области статических
+// матриц могли вернуть в него отображения в любом порядке.
+S21PageArena::Cache& S21PageArena::cache() {
+  static Cache* instance = new Cache;
+  return *instance;
+}
+
+// Отображение из кэша с видом страниц pages и размещением по узлам как
+// у области размером от size до 2 * size (наименьшее, среди равных -
+// освобождённое последним)
+bool S21PageArena::takeCached(std::size_t size, S21PagePolicy pages,
+                              Chunk& chunk) const {
+  Cache& shared = cache();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  auto best = shared.chunks.end();
+  for (auto it = shared.chunks.begin(); it != shared.chunks.end(); ++it) {
+    if (it->pages != pages || it->memory != memory_ || it->node != node_ ||
+        it->size < size || it->size > 2 * size) {
+      continue;
+    }
+    if (best == shared.chunks.end() || it->size <= best->size) best = it;
+  }
+  if (best == shared.chunks.end()) return false;
+  chunk = *best;
+  chunk.used = 0;
+  shared.bytes -= chunk.size;
+  shared.chunks.erase(best);
+  return true;
+}
+
+// Возврат отображения в кэш, при переполнении кэша - снятие
+void S21PageArena::release(const Chunk& chunk) noexcept {
+  Cache& shared = cache();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  if (shared.bytes + chunk.size <= kMaxCachedBytes) {
+    try {
+      shared.chunks.push_back(chunk);
+      shared.bytes += chunk.size;
+      return;
+    } catch (const std::bad_alloc&) {
+    }
+  }
+  munmap(chunk.base, chunk.size);
+}
+
+// Новое отображение размером не меньше bytes, кратное 2 МБ: из кэша или
+// через mmap. Опустевшее текущее отображение при этом возвращается в
+// кэш. При kBind и kInterleave новое отображение получает политику через
+// mbind до первой записи, у отображений из кэша она уже та же.
+void S21PageArena::mapChunk(std::size_t bytes) {
+  const std::size_t size = roundUp(bytes, kHugePageSize);
+  if (!chunks_.empty() && chunks_.back().used == 0) {
+    release(chunks_.back());
+    chunks_.pop_back();
+  }
+  const bool hugetlb = policy_ == S21PagePolicy::kHugeTlb;
+  // Без hugetlbfs область берёт прозрачные huge-страницы
+  const S21PagePolicy pages =
+      hugetlb ? S21PagePolicy::kTransparentHuge : policy_;
+  Chunk chunk{nullptr, size, 0, pages, false, memory_, node_};
+  if (!(hugetlb && takeCached(size, S21PagePolicy::kHugeTlb, chunk))) {
+    void* base = MAP_FAILED;
+    if (hugetlb) {
+      base = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (base != MAP_FAILED) {
+        chunk.base = static_cast<char*>(base);
+        chunk.pages = S21PagePolicy::kHugeTlb;
+        chunk.huge = true;
+      }
+    }
+    const bool fresh = base != MAP_FAILED || !takeCached(size, pages, chunk);
+    if (base == MAP_FAILED && fresh) mapPages(chunk);
+    if (fresh && memory_ != S21MemoryPolicy::kFirstTouch) {
+      S21Numa::BindMemory(chunk.base, size, memory_, node_);
+    }
+  }
+  chunks_.push_back(chunk);
+  huge_ = huge_ || chunk.huge;
+  cursor_ = chunk.base;
+  end_ = cursor_ + chunk.size;
+}
+
+// Отображение обычных страниц размером chunk.size. Для прозрачных
+// huge-страниц начало выравнивается на 2 МБ: лишние края отображения
+// снимаются, остаток помечается MADV_HUGEPAGE.
+void S21PageArena::mapPages(Chunk& chunk) const {
+  const std::size_t size = chunk.size;
+  if (chunk.pages == S21PagePolicy::kDefault) {
+    void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) throw std::bad_alloc();
+    chunk.base = static_cast<char*>(base);
+    return;
+  }
+  const std::size_t padded = size + kHugePageSize;
+  void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) throw std::bad_alloc();
+  const auto start = reinterpret_cast<std::uintptr_t>(raw);
+  const std::uintptr_t aligned = roundUp(start, kHugePageSize);
+  if (aligned > start) munmap(raw, aligned - start);
+  const std::size_t tail = start + padded - (aligned + size);
+  if (tail > 0) munmap(reinterpret_cast<void*>(aligned + size), tail);
+  chunk.base = reinterpret_cast<char*>(aligned);
+  const bool advised = madvise(chunk.base, size, MADV_HUGEPAGE) == 0;
+  chunk.huge = advised && transparentHugeEnabled();
+}
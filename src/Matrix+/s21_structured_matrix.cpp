@@ -0,0 +1,386 @@
+#include "s21_structured_matrix.h"
+
+#include <algorithm>
+
+namespace {
+// Строка результата += factor * строка источника
+void addScaledRow(double* target, const double* source, double factor,
+                  int count) {
+  for (int j = 0; j < count; ++j) target[j] += factor * source[j];
+}
+
+void checkDimensions(int rows, int cols) {
+  if (rows < 1 || cols < 1) {
+    throw std::invalid_argument("Matrix dimensions must be greater than 0.");
+  }
+}
+
+void checkIndices(int row, int col, int rows, int cols) {
+  if (row < 0 || row >= rows || col < 0 || col >= cols) {
+    throw std::out_of_range("Matrix indices out of range.");
+  }
+}
+}  // namespace
+
+// Треугольная матрица
+
+// Конструктор нулевой треугольной матрицы
+S21TriangularMatrix::S21TriangularMatrix(int size, S21Triangle triangle)
+    : size_(size), triangle_(triangle) {
+  checkDimensions(size, size);
+  data_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+// Треугольник плотной квадратной матрицы (остальные элементы
+// отбрасываются)
+S21TriangularMatrix S21TriangularMatrix::FromMatrix(const S21Matrix& matrix,
+                                                    S21Triangle triangle) {
+  if (matrix.getRows() != matrix.getCols()) {
+    throw std::invalid_argument("Matrix must be square.");
+  }
+  const int n = matrix.getRows();
+  S21TriangularMatrix result(n, triangle);
+  const S21Matrix source = matrix.rowMajor();
+  const S21Matrix::Storage& rows = *source.matrix_;
+  for (int i = 0; i < n; ++i) {
+    const int from = triangle == S21Triangle::kLower ? 0 : i;
+    const int to = triangle == S21Triangle::kLower ? i + 1 : n;
+    std::copy(rows[i].begin() + from, rows[i].begin() + to,
+              result.data_.begin() + result.index(i, from));
+  }
+  return result;
+}
+
+// Размер
+int S21TriangularMatrix::getSize() const noexcept { return size_; }
+
+// Хранимый треугольник
+S21Triangle S21TriangularMatrix::getTriangle() const noexcept {
+  return triangle_;
+}
+
+// Элемент (вне треугольника - ноль)
+double S21TriangularMatrix::getElement(int row, int col) const {
+  checkIndices(row, col, size_, size_);
+  return stored(row, col) ? data_[index(row, col)] : 0.0;
+}
+
+// Запись элемента треугольника
+void S21TriangularMatrix::SetElement(int row, int col, double value) {
+  checkIndices(row, col, size_, size_);
+  if (!stored(row, col)) {
+    throw std::out_of_range("Element is outside the matrix structure.");
+  }
+  data_[index(row, col)] = value;
+}
+
+// Определитель за O(n) - произведение диагонали
+double S21TriangularMatrix::Determinant() const noexcept {
+  double result = 1.0;
+  for (int i = 0; i < size_; ++i) result *= data_[index(i, i)];
+  return result;
+}
+
+// Произведение T * other за n^2 * cols / 2 умножений.
+// Строки результата распределяются между потоками.
+S21Matrix S21TriangularMatrix::MulMatrix(const S21Matrix& other) const {
+  if (other.getRows() != size_) {
+    throw std::invalid_argument("Matrix dimensions are not comparable.");
+  }
+  const int n = size_, cols = other.getCols();
+  const S21Matrix source = other.rowMajor();
+  const S21Matrix::Storage& b = *source.matrix_;
+  S21Matrix result(n, cols);
+  S21Matrix::Storage& c = *result.matrix_;
+  const bool lower = triangle_ == S21Triangle::kLower;
+  S21Matrix::parallelFor(
+      0, n, static_cast<long long>(n) * cols / 2, [&](int from, int to) {
+        for (int i = from; i < to; ++i) {
+          const int first = lower ? 0 : i, last = lower ? i + 1 : n;
+          const double* t = data_.data() + index(i, first) - first;
+          for (int k = first; k < last; ++k) {
+            addScaledRow(c[i].data(), b[k].data(), t[k], cols);
+          }
+        }
+      });
+  return result;
+}
+
+// Решение T * X = rhs прямой (для нижней) или обратной (для верхней)
+// подстановкой за n^2 * cols / 2 умножений. Столбцы правой части
+// независимы и делятся между потоками, внутри части строки обновляются
+// целиком по непрерывной памяти.
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix& rhs) const {
+  if (rhs.getRows() != size_) {
+    throw std::invalid_argument("Matrix dimensions are not comparable.");
+  }
+  const int n = size_, cols = rhs.getCols();
+  for (int i = 0; i < n; ++i) {
+    if (data_[index(i, i)] == 0.0) {
+      throw std::runtime_error("Matrix is singular.");
+    }
+  }
+  S21Matrix result = rhs.rowMajor();
+  result.detach();
+  S21Matrix::Storage& x = *result.matrix_;
+  const bool lower = triangle_ == S21Triangle::kLower;
+  S21Matrix::parallelFor(
+      0, cols, static_cast<long long>(n) * n / 2, [&](int from, int to) {
+        const int count = to - from;
+        for (int step = 0; step < n; ++step) {
+          const int i = lower ? step : n - 1 - step;
+          const int first = lower ? 0 : i + 1, last = lower ? i : n;
+          const double* t = data_.data() + index(i, i) - i;
+          double* row = x[i].data() + from;
+          for (int k = first; k < last; ++k) {
+            addScaledRow(row, x[k].data() + from, -t[k], count);
+          }
+          const double inverse = 1.0 / t[i];
+          for (int j = 0; j < count; ++j) row[j] *= inverse;
+        }
+      });
+  return result;
+}
+
+// Плотная копия
+S21Matrix S21TriangularMatrix::ToMatrix() const {
+  S21Matrix result(size_, size_);
+  S21Matrix::Storage& rows = *result.matrix_;
+  for (int i = 0; i < size_; ++i) {
+    const int from = triangle_ == S21Triangle::kLower ? 0 : i;
+    const int to = triangle_ == S21Triangle::kLower ? i + 1 : size_;
+    const auto first = data_.begin() + index(i, from);
+    std::copy(first, first + (to - from), rows[i].begin() + from);
+  }
+  return result;
+}
+
+// Смещение элемента треугольника в упакованном массиве
+size_t S21TriangularMatrix::index(int row, int col) const noexcept {
+  const size_t i = row, j = col, n = size_;
+  if (triangle_ == S21Triangle::kLower) return i * (i + 1) / 2 + j;
+  return i * n - i * (i - 1) / 2 + (j - i);
+}
+
+// Лежит ли элемент в хранимом треугольнике
+bool S21TriangularMatrix::stored(int row, int col) const noexcept {
+  return triangle_ == S21Triangle::kLower ? col <= row : col >= row;
+}
+
+// Симметричная матрица
+
+// Конструктор нулевой симметричной матрицы
+S21SymmetricMatrix::S21SymmetricMatrix(int size) : size_(size) {
+  checkDimensions(size, size);
+  data_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+// Упаковка плотной симметричной матрицы
+S21SymmetricMatrix S21SymmetricMatrix::FromMatrix(const S21Matrix& matrix) {
+  if (matrix.getRows() != matrix.getCols()) {
+    throw std::invalid_argument("Matrix must be square.");
+  }
+  if (!matrix.EqMatrix(matrix.Transpose(), 1e-12 * matrix.FrobeniusNorm(),
+                       1e-9)) {
+    throw std::invalid_argument("Matrix must be symmetric.");
+  }
+  const int n = matrix.getRows();
+  S21SymmetricMatrix result(n);
+  const S21Matrix source = matrix.rowMajor();
+  const S21Matrix::Storage& rows = *source.matrix_;
+  for (int i = 0; i < n; ++i) {
+    std::copy(rows[i].begin(), rows[i].begin() + i + 1,
+              result.data_.begin() + result.index(i, 0));
+  }
+  return result;
+}
+
+// Размер
+int S21SymmetricMatrix::getSize() const noexcept { return size_; }
+
+// Элемент
+double S21SymmetricMatrix::getElement(int row, int col) const {
+  checkIndices(row, col, size_, size_);
+  return data_[index(row, col)];
+}
+
+// Запись элемента (и симметричного ему)
+void S21SymmetricMatrix::SetElement(int row, int col, double value) {
+  checkIndices(row, col, size_, size_);
+  data_[index(row, col)] = value;
+}
+
+// Произведение S * other. Для строки i элементы левее диагонали берутся
+// из строки i упакованного массива, правее - из столбца i.
+S21Matrix S21SymmetricMatrix::MulMatrix(const S21Matrix& other) const {
+  if (other.getRows() != size_) {
+    throw std::invalid_argument("Matrix dimensions are not comparable.");
+  }
+  const int n = size_, cols = other.getCols();
+  const S21Matrix source = other.rowMajor();
+  const S21Matrix::Storage& b = *source.matrix_;
+  S21Matrix result(n, cols);
+  S21Matrix::Storage& c = *result.matrix_;
+  S21Matrix::parallelFor(
+      0, n, static_cast<long long>(n) * cols, [&](int from, int to) {
+        for (int i = from; i < to; ++i) {
+          const double* s = data_.data() + index(i, 0);
+          for (int k = 0; k <= i; ++k) {
+            addScaledRow(c[i].data(), b[k].data(), s[k], cols);
+          }
+          for (int k = i + 1; k < n; ++k) {
+            addScaledRow(c[i].data(), b[k].data(), data_[index(k, i)], cols);
+          }
+        }
+      });
+  return result;
+}
+
+// Симметричное обновление ранга k: S = alpha * A * A^T + beta * S,
+// где A - n x k. Считается только нижний треугольник, то есть вдвое
+// меньше умножений, чем в плотном A * A^T.
+void S21SymmetricMatrix::RankKUpdate(const S21Matrix& a, double alpha,
+                                     double beta) {
+  if (a.getRows() != size_) {
+    throw std::invalid_argument("Matrix dimensions are not comparable.");
+  }
+  const int n = size_, k = a.getCols();
+  const S21Matrix source = a.rowMajor();
+  const S21Matrix::Storage& rows = *source.matrix_;
+  S21Matrix::parallelFor(
+      0, n, static_cast<long long>(n) * k / 2, [&](int from, int to) {
+        for (int i = from; i < to; ++i) {
+          double* s = data_.data() + index(i, 0);
+          const double* ai = rows[i].data();
+          for (int j = 0; j <= i; ++j) {
+            const double* aj = rows[j].data();
+            double dot = 0.0;
+            for (int p = 0; p < k; ++p) dot += ai[p] * aj[p];
+            s[j] = beta * s[j] + alpha * dot;
+          }
+        }
+      });
+}
+
+// Плотная копия
+S21Matrix S21SymmetricMatrix::ToMatrix() const {
+  S21Matrix result(size_, size_);
+  S21Matrix::Storage& rows = *result.matrix_;
+  for (int i = 0; i < size_; ++i) {
+    for (int j = 0; j <= i; ++j) rows[i][j] = rows[j][i] = data_[index(i, j)];
+  }
+  return result;
+}
+
+// Смещение элемента в упакованном нижнем треугольнике
+size_t S21SymmetricMatrix::index(int row, int col) const noexcept {
+  const size_t i = std::max(row, col), j = std::min(row, col);
+  return i * (i + 1) / 2 + j;
+}
+
+// Ленточная матрица
+
+// Конструктор нулевой ленточной матрицы
+S21BandMatrix::S21BandMatrix(int rows, int cols, int lower, int upper)
+    : rows_(rows), cols_(cols), lower_(lower), upper_(upper) {
+  checkDimensions(rows, cols);
+  if (lower < 0 || upper < 0) {
+    throw std::invalid_argument("Band widths must be non-negative.");
+  }
+  lower_ = std::min(lower, rows - 1);
+  upper_ = std::min(upper, cols - 1);
+  data_.assign(static_cast<size_t>(rows) * width(), 0.0);
+}
+
+// Лента плотной матрицы (элементы вне ленты отбрасываются)
+S21BandMatrix S21BandMatrix::FromMatrix(const S21Matrix& matrix, int lower,
+                                        int upper) {
+  S21BandMatrix result(matrix.getRows(), matrix.getCols(), lower, upper);
+  const S21Matrix source = matrix.rowMajor();
+  const S21Matrix::Storage& rows = *source.matrix_;
+  for (int i = 0; i < result.rows_; ++i) {
+    const int from = std::max(0, i - result.lower_);
+    const int to = std::min(result.cols_, i + result.upper_ + 1);
+    for (int j = from; j < to; ++j) {
+      result.data_[static_cast<size_t>(i) * result.width() + j - i +
+                   result.lower_] = rows[i][j];
+    }
+  }
+  return result;
+}
+
+// Число строк
+int S21BandMatrix::getRows() const noexcept { return rows_; }
+
+// Число столбцов
+int S21BandMatrix::getCols() const noexcept { return cols_; }
+
+// Число поддиагоналей
+int S21BandMatrix::getLower() const noexcept { return lower_; }
+
+// Число наддиагоналей
+int S21BandMatrix::getUpper() const noexcept { return upper_; }
+
+// Элемент (вне ленты - ноль)
+double S21BandMatrix::getElement(int row, int col) const {
+  checkIndices(row, col, rows_, cols_);
+  if (!stored(row, col)) return 0.0;
+  return data_[static_cast<size_t>(row) * width() + col - row + lower_];
+}
+
+// Запись элемента ленты
+void S21BandMatrix::SetElement(int row, int col, double value) {
+  checkIndices(row, col, rows_, cols_);
+  if (!stored(row, col)) {
+    throw std::out_of_range("Element is outside the matrix structure.");
+  }
+  data_[static_cast<size_t>(row) * width() + col - row + lower_] = value;
+}
+
+// Произведение B * other за rows * (lower + upper + 1) * cols умножений
+S21Matrix S21BandMatrix::MulMatrix(const S21Matrix& other) const {
+  if (other.getRows() != cols_) {
+    throw std::invalid_argument("Matrix dimensions are not comparable.");
+  }
+  const int cols = other.getCols();
+  const S21Matrix source = other.rowMajor();
+  const S21Matrix::Storage& b = *source.matrix_;
+  S21Matrix result(rows_, cols);
+  S21Matrix::Storage& c = *result.matrix_;
+  S21Matrix::parallelFor(
+      0, rows_, static_cast<long long>(width()) * cols,
+      [&](int from, int to) {
+        for (int i = from; i < to; ++i) {
+          const double* band =
+              data_.data() + static_cast<size_t>(i) * width() + lower_ - i;
+          const int first = std::max(0, i - lower_);
+          const int last = std::min(cols_, i + upper_ + 1);
+          for (int k = first; k < last; ++k) {
+            addScaledRow(c[i].data(), b[k].data(), band[k], cols);
+          }
+        }
+      });
+  return result;
+}
+
+// Плотная копия
+S21Matrix S21BandMatrix::ToMatrix() const {
+  S21Matrix result(rows_, cols_);
+  S21Matrix::Storage& rows = *result.matrix_;
+  for (int i = 0; i < rows_; ++i) {
+    const int from = std::max(0, i - lower_);
+    const int to = std::min(cols_, i + upper_ + 1);
+    for (int j = from; j < to; ++j) {
+      rows[i][j] = data_[static_cast<size_t>(i) * width() + j - i + lower_];
+    }
+  }
+  return result;
+}
+
+// Длина хранимой части строки
+int S21BandMatrix::width() const noexcept { return lower_ + upper_ + 1; }
+
+// Лежит ли элемент в ленте
+bool S21BandMatrix::stored(int row, int col) const noexcept {
+  return col - row <= upper_ && row - col <= lower_;
+}
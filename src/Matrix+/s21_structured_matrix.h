@@ -0,0 +1,91 @@
+#ifndef S21_STRUCTURED_MATRIX_H
+#define S21_STRUCTURED_MATRIX_H
+
+#include <vector>
+
+#include "s21_matrix.h"
+
+// Какой треугольник матрицы хранится
+enum class S21Triangle { kLower, kUpper };
+
+// Треугольная матрица n x n. Хранится только треугольник, построчно
+// и без пропусков (n(n+1)/2 элементов), остальные элементы равны нулю.
+class S21TriangularMatrix {
+ public:
+  S21TriangularMatrix(int size, S21Triangle triangle);
+  static S21TriangularMatrix FromMatrix(const S21Matrix& matrix,
+                                        S21Triangle triangle);
+
+  int getSize() const noexcept;
+  S21Triangle getTriangle() const noexcept;
+  double getElement(int row, int col) const;
+  void SetElement(int row, int col, double value);
+
+  double Determinant() const noexcept;
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  S21Matrix Solve(const S21Matrix& rhs) const;
+  S21Matrix ToMatrix() const;
+
+ private:
+  size_t index(int row, int col) const noexcept;
+  bool stored(int row, int col) const noexcept;
+
+  int size_;
+  S21Triangle triangle_;
+  std::vector<double> data_;
+};
+
+// Симметричная матрица n x n. Хранится нижний треугольник построчно
+// (n(n+1)/2 элементов), запись элемента меняет оба симметричных.
+class S21SymmetricMatrix {
+ public:
+  explicit S21SymmetricMatrix(int size);
+  static S21SymmetricMatrix FromMatrix(const S21Matrix& matrix);
+
+  int getSize() const noexcept;
+  double getElement(int row, int col) const;
+  void SetElement(int row, int col, double value);
+
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  void RankKUpdate(const S21Matrix& a, double alpha = 1.0, double beta = 1.0);
+  S21Matrix ToMatrix() const;
+
+ private:
+  size_t index(int row, int col) const noexcept;
+
+  int size_;
+  std::vector<double> data_;
+};
+
+// Ленточная матрица rows x cols с lower поддиагоналями и upper
+// наддиагоналями. Строка i хранит элементы столбцов i - lower ..
+// i + upper (lower + upper + 1 элементов, выходящие за матрицу не
+// используются).
+class S21BandMatrix {
+ public:
+  S21BandMatrix(int rows, int cols, int lower, int upper);
+  static S21BandMatrix FromMatrix(const S21Matrix& matrix, int lower,
+                                  int upper);
+
+  int getRows() const noexcept;
+  int getCols() const noexcept;
+  int getLower() const noexcept;
+  int getUpper() const noexcept;
+  double getElement(int row, int col) const;
+  void SetElement(int row, int col, double value);
+
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  S21Matrix ToMatrix() const;
+
+ private:
+  int width() const noexcept;
+  bool stored(int row, int col) const noexcept;
+
+  int rows_;
+  int cols_;
+  int lower_;
+  int upper_;
+  std::vector<double> data_;
+};
+
+#endif
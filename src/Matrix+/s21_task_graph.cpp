@@ -0,0 +1,143 @@
+#include "s21_task_graph.h"
+
+#include <thread>
+
+#include "s21_thread_pool.h"
+
+// Описание узлов
+
+// Исходная матрица (хранилище разделяется с аргументом до первой записи)
+S21TaskGraph::Node S21TaskGraph::Input(const S21Matrix& matrix) {
+  S21Matrix value = matrix.share();
+  return addNode(
+      [value](const std::vector<const S21Matrix*>&) { return value.share(); },
+      {});
+}
+
+// Сумма
+S21TaskGraph::Node S21TaskGraph::Sum(Node left, Node right) {
+  return addNode(
+      [](const std::vector<const S21Matrix*>& args) {
+        return *args[0] + *args[1];
+      },
+      {left, right});
+}
+
+// Разность
+S21TaskGraph::Node S21TaskGraph::Sub(Node left, Node right) {
+  return addNode(
+      [](const std::vector<const S21Matrix*>& args) {
+        return *args[0] - *args[1];
+      },
+      {left, right});
+}
+
+// Произведение матриц
+S21TaskGraph::Node S21TaskGraph::Mul(Node left, Node right) {
+  return addNode(
+      [](const std::vector<const S21Matrix*>& args) {
+        return *args[0] * *args[1];
+      },
+      {left, right});
+}
+
+// Умножение на число
+S21TaskGraph::Node S21TaskGraph::MulNumber(Node node, double num) {
+  return addNode(
+      [num](const std::vector<const S21Matrix*>& args) {
+        return *args[0] * num;
+      },
+      {node});
+}
+
+// Транспонирование
+S21TaskGraph::Node S21TaskGraph::Transpose(Node node) {
+  return addNode(
+      [](const std::vector<const S21Matrix*>& args) {
+        return args[0]->Transpose();
+      },
+      {node});
+}
+
+// Обратная матрица
+S21TaskGraph::Node S21TaskGraph::Inverse(Node node) {
+  return addNode(
+      [](const std::vector<const S21Matrix*>& args) {
+        return args[0]->InverseMatrix();
+      },
+      {node});
+}
+
+// Выполнение графа
+void S21TaskGraph::Run() {
+  error_ = nullptr;
+  has_error_ = false;
+  remaining_ = static_cast<int>(tasks_.size());
+  for (auto& task : tasks_) {
+    task->waiting = static_cast<int>(task->inputs.size());
+    task->failed = false;
+  }
+  for (Node node = 0; node < static_cast<Node>(tasks_.size()); ++node) {
+    if (tasks_[node]->inputs.empty()) schedule(node);
+  }
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  while (remaining_ > 0) {
+    if (!pool.RunPendingTask()) std::this_thread::yield();
+  }
+  if (error_) std::rethrow_exception(error_);
+}
+
+// Результат узла после Run()
+const S21Matrix& S21TaskGraph::Result(Node node) const {
+  if (node < 0 || node >= static_cast<Node>(tasks_.size())) {
+    throw std::out_of_range("Task graph node out of range.");
+  }
+  return tasks_[node]->value;
+}
+
+// Приватные вспомогательные функции
+
+// Добавление узла, аргументы должны быть описаны раньше него
+S21TaskGraph::Node S21TaskGraph::addNode(Operation operation,
+                                         std::vector<Node> inputs) {
+  const Node node = static_cast<Node>(tasks_.size());
+  for (Node input : inputs) {
+    if (input < 0 || input >= node) {
+      throw std::out_of_range("Task graph node out of range.");
+    }
+  }
+  auto task = std::make_unique<Task>();
+  task->operation = std::move(operation);
+  task->inputs = std::move(inputs);
+  for (Node input : task->inputs) tasks_[input]->dependents.push_back(node);
+  tasks_.push_back(std::move(task));
+  return node;
+}
+
+// Отправка готового узла в пул
+void S21TaskGraph::schedule(Node node) {
+  S21ThreadPool::Instance().Post([this, node]() { execute(node); });
+}
+
+// Вычисление узла и запуск освободившихся зависимых узлов.
+// Если аргумент не был вычислен, узел тоже помечается неудачным.
+void S21TaskGraph::execute(Node node) {
+  Task& task = *tasks_[node];
+  std::vector<const S21Matrix*> args;
+  for (Node input : task.inputs) {
+    if (tasks_[input]->failed) task.failed = true;
+    args.push_back(&tasks_[input]->value);
+  }
+  if (!task.failed) {
+    try {
+      task.value = task.operation(args);
+    } catch (...) {
+      task.failed = true;
+      if (!has_error_.exchange(true)) error_ = std::current_exception();
+    }
+  }
+  for (Node dependent : task.dependents) {
+    if (--tasks_[dependent]->waiting == 0) schedule(dependent);
+  }
+  --remaining_;
+}
@@ -0,0 +1,59 @@
+#ifndef S21_TASK_GRAPH_H
+#define S21_TASK_GRAPH_H
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "s21_matrix.h"
+
+// Граф зависимостей между операциями над матрицами.
+// Узлы описываются заранее, Run() запускает на общем пуле потоков каждый
+// узел, как только готовы все его аргументы, так что независимые ветви
+// выполняются одновременно.
+class S21TaskGraph {
+ public:
+  using Node = int;
+
+  S21TaskGraph() = default;
+  S21TaskGraph(const S21TaskGraph&) = delete;
+  S21TaskGraph& operator=(const S21TaskGraph&) = delete;
+
+  // Описание узлов
+  Node Input(const S21Matrix& matrix);
+  Node Sum(Node left, Node right);
+  Node Sub(Node left, Node right);
+  Node Mul(Node left, Node right);
+  Node MulNumber(Node node, double num);
+  Node Transpose(Node node);
+  Node Inverse(Node node);
+  // Выполнение графа, первое возникшее исключение пробрасывается дальше
+  void Run();
+  const S21Matrix& Result(Node node) const;
+
+ private:
+  using Operation =
+      std::function<S21Matrix(const std::vector<const S21Matrix*>&)>;
+
+  struct Task {
+    Operation operation;
+    std::vector<Node> inputs;
+    std::vector<Node> dependents;
+    S21Matrix value;
+    std::atomic<int> waiting{0};
+    bool failed = false;
+  };
+
+  Node addNode(Operation operation, std::vector<Node> inputs);
+  void schedule(Node node);
+  void execute(Node node);
+
+  std::vector<std::unique_ptr<Task>> tasks_;
+  std::atomic<int> remaining_{0};
+  std::exception_ptr error_;
+  std::atomic<bool> has_error_{false};
+};
+
+#endif
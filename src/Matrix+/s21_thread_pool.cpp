@@ -0,0 +1,217 @@
+#include "s21_thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#include "s21_numa.h"
+
+namespace {
+// Минимальный объём работы, ради которого стоит ставить задачу в пул
+constexpr long long kMinWorkPerThread = 1 << 16;
+
+// Номер очереди текущего рабочего потока, -1 для внешних потоков
+thread_local int current_worker = -1;
+thread_local const S21ThreadPool* current_pool = nullptr;
+}  // namespace
+
+// Запуск рабочих потоков
+S21ThreadPool::S21ThreadPool(int threads, bool pin)
+    : pending_(0), next_queue_(0), stop_(false) {
+  if (threads < 1) {
+    throw std::invalid_argument("Thread pool must have at least one thread.");
+  }
+  for (int i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  const std::vector<int> cpus =
+      pin ? S21Numa::CpusByNode() : std::vector<int>();
+  workers_.reserve(threads);
+  for (int i = 0; i < threads; ++i) {
+    const int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+    workers_.emplace_back(&S21ThreadPool::workerLoop, this, i, cpu);
+  }
+}
+
+// Остановка после выполнения всех поставленных задач
+S21ThreadPool::~S21ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) worker.join();
+}
+
+// Общий пул: по потоку на доступный процессор, на машинах с несколькими
+// узлами NUMA потоки закрепляются, чтобы рабочий поток t оставался на
+// одном узле и части ParallelForPinned размещали страницы предсказуемо
+S21ThreadPool& S21ThreadPool::Instance() {
+  static S21ThreadPool pool(
+      static_cast<int>(std::max<size_t>(1, S21Numa::CpusByNode().size())),
+      S21Numa::NodeCount() > 1);
+  return pool;
+}
+
+// Число рабочих потоков
+int S21ThreadPool::Size() const noexcept {
+  return static_cast<int>(workers_.size());
+}
+
+// Постановка задачи: рабочий поток кладёт её в свою очередь,
+// внешний поток - в очереди по кругу
+void S21ThreadPool::Post(Task task) {
+  int index = current_pool == this ? current_worker : -1;
+  if (index < 0) {
+    index = static_cast<int>(next_queue_++ % queues_.size());
+  }
+  postTo(index, std::move(task), false);
+}
+
+// Постановка задачи в очередь конкретного рабочего потока. Закреплённую
+// задачу может взять только он, поэтому будятся все потоки.
+void S21ThreadPool::postTo(int index, Task task, bool pinned) {
+  Queue& queue = *queues_[index];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    (pinned ? queue.pinned : queue.tasks).push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    ++(pinned ? queue.pinned_pending : pending_);
+  }
+  if (pinned) {
+    wake_.notify_all();
+  } else {
+    wake_.notify_one();
+  }
+}
+
+// Выполнение одной задачи из любой очереди (закреплённой - только
+// в рабочем потоке, за которым она закреплена)
+bool S21ThreadPool::RunPendingTask() {
+  Task task;
+  const bool worker = current_pool == this;
+  if (!popTask(worker ? current_worker : 0, worker, task)) return false;
+  task();
+  return true;
+}
+
+// Разбиение диапазона [begin, end) на части для пула потоков.
+// cost - примерное число операций на один индекс: мелкие задачи
+// выполняются в вызывающем потоке без накладных расходов на постановку.
+// Часть t ставится в очередь рабочего t, последнюю часть выполняет
+// вызывающий поток, а простаивающие потоки перехватывают чужие части,
+// так что поток, выполнивший часть, заранее не известен.
+void S21ThreadPool::ParallelFor(int begin, int end, long long cost,
+                                const std::function<void(int, int)>& body) {
+  runParts(begin, end, cost, body, false);
+}
+
+// Разбиение как в ParallelFor, но каждая часть t выполняется рабочим
+// потоком t: части не перехватываются и не выполняются вызывающим
+// потоком. Нужно для циклов первого касания, размещающих страницы на
+// узле NUMA рабочего потока. Мелкие циклы по-прежнему выполняются
+// вызывающим потоком.
+void S21ThreadPool::ParallelForPinned(
+    int begin, int end, long long cost,
+    const std::function<void(int, int)>& body) {
+  runParts(begin, end, cost, body, true);
+}
+
+// Общая часть параллельных циклов. Пока части выполняются, вызывающий
+// поток сам берёт задачи из очередей.
+void S21ThreadPool::runParts(int begin, int end, long long cost,
+                             const std::function<void(int, int)>& body,
+                             bool pinned) {
+  const long long count = end - begin;
+  if (count <= 0) return;
+  long long parts = std::min<long long>(Size(), count);
+  parts = std::min(parts, count * cost / kMinWorkPerThread);
+  if (parts <= 1) {
+    body(begin, end);
+    return;
+  }
+  std::atomic<long long> remaining(pinned ? parts : parts - 1);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto run = [&](int from, int to) {
+    try {
+      body(from, to);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) error = std::current_exception();
+    }
+  };
+  const long long chunk = count / parts, rest = count % parts;
+  int from = begin;
+  for (long long t = 0; t < parts; ++t) {
+    const int to = from + static_cast<int>(chunk + (t < rest ? 1 : 0));
+    if (!pinned && t + 1 == parts) {
+      run(from, to);
+    } else {
+      postTo(
+          static_cast<int>(t),
+          [&run, &remaining, from, to]() {
+            run(from, to);
+            --remaining;
+          },
+          pinned);
+    }
+    from = to;
+  }
+  while (remaining > 0) {
+    if (!RunPendingTask()) std::this_thread::yield();
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+// Цикл рабочего потока
+void S21ThreadPool::workerLoop(int index, int cpu) {
+  if (cpu >= 0) S21Numa::PinCurrentThread(cpu);
+  current_worker = index;
+  current_pool = this;
+  for (;;) {
+    Task task;
+    if (popTask(index, true, task)) {
+      task();
+      continue;
+    }
+    const std::atomic<int>& pinned = queues_[index]->pinned_pending;
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_.wait(lock,
+               [&] { return stop_ || pending_ > 0 || pinned > 0; });
+    if (stop_ && pending_ <= 0 && pinned <= 0) break;
+  }
+}
+
+// Закреплённая задача владельца очереди, иначе задача из конца своей
+// очереди или из начала чужой
+bool S21ThreadPool::popTask(int index, bool owner, Task& task) {
+  if (owner) {
+    Queue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.pinned.empty()) {
+      task = std::move(queue.pinned.front());
+      queue.pinned.pop_front();
+      --queue.pinned_pending;
+      return true;
+    }
+  }
+  const int count = static_cast<int>(queues_.size());
+  for (int shift = 0; shift < count; ++shift) {
+    Queue& queue = *queues_[(index + shift) % count];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) continue;
+    if (shift == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    --pending_;
+    return true;
+  }
+  return false;
+}
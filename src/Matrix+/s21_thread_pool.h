@@ -0,0 +1,79 @@
+#ifndef S21_THREAD_POOL_H
+#define S21_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков с перехватом задач (work stealing).
+// У каждого рабочего потока своя очередь: новые задачи рабочего кладутся
+// в её конец и берутся оттуда же, простаивающие потоки забирают задачи
+// из начала чужих очередей. Части ParallelForPinned кладутся в отдельные
+// очереди, которые не перехватываются. При pin рабочие потоки
+// закрепляются за процессорами по порядку узлов NUMA.
+class S21ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  explicit S21ThreadPool(int threads, bool pin = false);
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+  ~S21ThreadPool();
+
+  // Общий пул на все ядра машины
+  static S21ThreadPool& Instance();
+
+  int Size() const noexcept;
+  void Post(Task task);
+  // Выполнение одной ожидающей задачи в вызывающем потоке.
+  // Используется для помощи пулу во время ожидания, что исключает
+  // взаимную блокировку при вложенных ожиданиях внутри задач.
+  bool RunPendingTask();
+  // Параллельный цикл по [begin, end), cost - число операций на индекс
+  void ParallelFor(int begin, int end, long long cost,
+                   const std::function<void(int, int)>& body);
+  // Параллельный цикл, часть t которого выполняет только рабочий поток t
+  void ParallelForPinned(int begin, int end, long long cost,
+                         const std::function<void(int, int)>& body);
+
+  template <class F>
+  std::future<decltype(std::declval<F&>()())> Submit(F&& function) {
+    using Result = decltype(std::declval<F&>()());
+    auto task = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<F>(function));
+    std::future<Result> future = task->get_future();
+    Post([task]() { (*task)(); });
+    return future;
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    // Задачи, которые может выполнить только владелец очереди
+    std::deque<Task> pinned;
+    std::atomic<int> pinned_pending{0};
+  };
+
+  void postTo(int index, Task task, bool pinned);
+  void runParts(int begin, int end, long long cost,
+                const std::function<void(int, int)>& body, bool pinned);
+  void workerLoop(int index, int cpu);
+  bool popTask(int index, bool owner, Task& task);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<int> pending_;
+  std::atomic<unsigned> next_queue_;
+  bool stop_;
+};
+
+#endif
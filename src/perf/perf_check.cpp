@@ -0,0 +1,388 @@
+// Проверка производительности: фиксированный набор нагрузок сравнивается
+// с базовыми значениями из файла, регрессия завершает программу с кодом 1.
+//
+//   perf_check <baseline>            - сравнение с базой
+//   perf_check --update <baseline>   - перезапись базы текущими замерами
+//
+// Для каждой нагрузки выполняется kRepeats замеров, сравнивается медиана.
+// Регрессией считается медиана, превышающая базовую более чем в max_ratio
+// раз, при условии что превышение больше трёх медианных отклонений (MAD).
+// Счётчики процессора читаются через perf_event_open по всем потокам
+// процесса; если ядро их не предоставляет, в отчёте выводится n/a.
+// Нагрузки с суффиксом _huge используют хранилище на прозрачных
+// huge-страницах: после таблицы их время и промахи dTLB выводятся
+// относительно того же варианта на обычных страницах.
+
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Matrix+/s21_matrix.h"
+#include "../Matrix+/s21_structured_matrix.h"
+#include "../Matrix+/s21_thread_pool.h"
+
+namespace {
+
+constexpr int kRepeats = 9;
+constexpr double kDefaultMaxRatio = 2.0;
+
+volatile double sink = 0.0;
+// Получили ли матрицы нагрузок _huge huge-страницы на самом деле
+bool huge_backed = false;
+
+// Счётчики cycles, instructions, cache-misses и промахов dTLB при чтении,
+// открытые для каждого потока процесса (в том числе для рабочих потоков
+// пула)
+class PerfCounters {
+ public:
+  static constexpr int kEvents = 4;
+
+  PerfCounters() {
+    const std::uint32_t types[kEvents] = {
+        PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+        PERF_TYPE_HW_CACHE};
+    const std::uint64_t configs[kEvents] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)};
+    DIR* tasks = opendir("/proc/self/task");
+    if (tasks == nullptr) return;
+    while (dirent* entry = readdir(tasks)) {
+      if (entry->d_name[0] == '.') continue;
+      const pid_t tid = static_cast<pid_t>(std::atoi(entry->d_name));
+      for (int e = 0; e < kEvents; ++e) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = types[e];
+        attr.config = configs[e];
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        const long fd = syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0);
+        if (fd >= 0) fds_[e].push_back(static_cast<int>(fd));
+      }
+    }
+    closedir(tasks);
+  }
+
+  ~PerfCounters() {
+    for (auto& fds : fds_) {
+      for (int fd : fds) close(fd);
+    }
+  }
+
+  bool Available(int event) const { return !fds_[event].empty(); }
+
+  std::uint64_t Read(int event) const {
+    std::uint64_t total = 0;
+    for (int fd : fds_[event]) {
+      std::uint64_t value = 0;
+      if (read(fd, &value, sizeof(value)) == sizeof(value)) total += value;
+    }
+    return total;
+  }
+
+ private:
+  std::vector<int> fds_[kEvents];
+};
+
+struct Workload {
+  std::string name;
+  std::function<void()> run;
+};
+
+struct Measurement {
+  double median_ns = 0.0;
+  double mad_ns = 0.0;
+  double counters[PerfCounters::kEvents] = {};
+};
+
+struct Baseline {
+  double median_ns = 0.0;
+  double max_ratio = kDefaultMaxRatio;
+};
+
+S21Matrix filled(int rows, int cols, double seed,
+                 S21PagePolicy pages = S21PagePolicy::kDefault) {
+  S21Matrix matrix(rows, cols, pages);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      matrix(i, j) = std::sin(seed + i * 0.7 + j * 1.3) + (i == j ? cols : 0);
+    }
+  }
+  return matrix;
+}
+
+std::vector<Workload> workloads() {
+  std::vector<Workload> result;
+  for (int n : {64, 128, 256}) {
+    auto a = std::make_shared<S21Matrix>(filled(n, n, 1.0));
+    auto b = std::make_shared<S21Matrix>(filled(n, n, 2.0));
+    result.push_back({"gemm_" + std::to_string(n), [a, b]() {
+                        sink = (*a * *b)(0, 0);
+                      }});
+  }
+  {
+    auto a = std::make_shared<S21Matrix>(filled(256, 256, 1.0));
+    auto b = std::make_shared<S21Matrix>(filled(256, 256, 2.0));
+    auto lower = std::make_shared<S21TriangularMatrix>(
+        S21TriangularMatrix::FromMatrix(*a, S21Triangle::kLower));
+    result.push_back({"trmm_256", [lower, b]() {
+                        sink = lower->MulMatrix(*b)(0, 0);
+                      }});
+    result.push_back({"trsm_256", [lower, b]() {
+                        sink = lower->Solve(*b)(0, 0);
+                      }});
+    result.push_back({"syrk_256", [a]() {
+                        S21SymmetricMatrix c(256);
+                        c.RankKUpdate(*a);
+                        sink = c.getElement(0, 0);
+                      }});
+  }
+  for (int n : {64, 128}) {
+    auto a = std::make_shared<S21Matrix>(filled(n, n, 3.0));
+    result.push_back({"inverse_" + std::to_string(n),
+                      [a]() { sink = a->InverseMatrix()(0, 0); }});
+    result.push_back({"determinant_" + std::to_string(n),
+                      [a]() { sink = a->Determinant(); }});
+  }
+  {
+    auto a = std::make_shared<S21Matrix>(filled(128, 128, 6.0));
+    auto symmetric = std::make_shared<S21Matrix>(*a + a->Transpose());
+    result.push_back({"eigen_128", [symmetric]() {
+                        sink = symmetric->SymmetricEigen().values(0, 0);
+                      }});
+    result.push_back(
+        {"svd_128", [a]() { sink = a->SVD().values(0, 0); }});
+    auto scaled = std::make_shared<S21Matrix>(*a * (1.0 / a->InfNorm()));
+    result.push_back({"pow_128_1000000", [scaled]() {
+                        sink = scaled->Pow(1000000)(0, 0);
+                      }});
+    result.push_back({"exp_128", [a]() { sink = a->Exp()(0, 0); }});
+  }
+  for (int n : {256, 1024}) {
+    auto a = std::make_shared<S21Matrix>(filled(n, n, 4.0));
+    auto b = std::make_shared<S21Matrix>(filled(n, n, 5.0));
+    result.push_back({"transpose_" + std::to_string(n), [a]() {
+                        const S21Matrix transposed = a->Transpose();
+                        sink = transposed(0, 1);
+                      }});
+    result.push_back({"materialize_" + std::to_string(n), [a]() {
+                        S21Matrix transposed = a->Transpose();
+                        transposed.Materialize();
+                        sink = transposed(0, 1);
+                      }});
+    result.push_back({"sum_" + std::to_string(n),
+                      [a, b]() { sink = (*a + *b)(0, 0); }});
+    result.push_back({"mul_number_" + std::to_string(n),
+                      [a]() { sink = (*a * 2.0)(0, 0); }});
+  }
+  {
+    const S21PagePolicy huge = S21PagePolicy::kTransparentHuge;
+    auto a = std::make_shared<S21Matrix>(filled(1024, 1024, 4.0, huge));
+    auto b = std::make_shared<S21Matrix>(filled(1024, 1024, 5.0, huge));
+    huge_backed = a->HugePages() && b->HugePages();
+    result.push_back({"materialize_1024_huge", [a]() {
+                        S21Matrix transposed = a->Transpose();
+                        transposed.Materialize();
+                        sink = transposed(0, 1);
+                      }});
+    result.push_back(
+        {"sum_1024_huge", [a, b]() { sink = (*a + *b)(0, 0); }});
+  }
+  {
+    auto a = std::make_shared<S21Matrix>(filled(1024, 1024, 7.0));
+    auto text = std::make_shared<std::string>();
+    {
+      std::ostringstream output;
+      a->ToCSV(output);
+      *text = output.str();
+    }
+    result.push_back({"to_csv_1024", [a]() {
+                        std::ostringstream output;
+                        a->ToCSV(output);
+                        sink = static_cast<double>(output.tellp());
+                      }});
+    result.push_back({"parse_csv_1024", [text]() {
+                        sink = S21Matrix::ParseCSV(*text)(0, 0);
+                      }});
+  }
+  return result;
+}
+
+double median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  const size_t middle = values.size() / 2;
+  return values.size() % 2 ? values[middle]
+                           : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+Measurement measure(const Workload& workload, const PerfCounters& counters) {
+  workload.run();
+  std::vector<double> times;
+  std::vector<double> events[PerfCounters::kEvents];
+  for (int r = 0; r < kRepeats; ++r) {
+    std::uint64_t before[PerfCounters::kEvents];
+    for (int e = 0; e < PerfCounters::kEvents; ++e) before[e] = counters.Read(e);
+    const auto start = std::chrono::steady_clock::now();
+    workload.run();
+    const auto finish = std::chrono::steady_clock::now();
+    for (int e = 0; e < PerfCounters::kEvents; ++e) {
+      events[e].push_back(static_cast<double>(counters.Read(e) - before[e]));
+    }
+    times.push_back(
+        std::chrono::duration<double, std::nano>(finish - start).count());
+  }
+  Measurement result;
+  result.median_ns = median(times);
+  std::vector<double> deviations;
+  for (double time : times) deviations.push_back(std::abs(time - result.median_ns));
+  result.mad_ns = median(deviations);
+  for (int e = 0; e < PerfCounters::kEvents; ++e) {
+    result.counters[e] = median(events[e]);
+  }
+  return result;
+}
+
+std::map<std::string, Baseline> readBaseline(const std::string& path) {
+  std::map<std::string, Baseline> result;
+  std::ifstream input(path);
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    std::string name;
+    Baseline baseline;
+    if (fields >> name >> baseline.median_ns) {
+      if (!(fields >> baseline.max_ratio)) baseline.max_ratio = kDefaultMaxRatio;
+      result[name] = baseline;
+    }
+  }
+  return result;
+}
+
+bool writeBaseline(const std::string& path,
+                   const std::vector<std::pair<std::string, Measurement>>& runs,
+                   const std::map<std::string, Baseline>& previous) {
+  std::ofstream output(path);
+  if (!output) return false;
+  output << "# workload median_ns max_ratio\n";
+  for (const auto& run : runs) {
+    auto found = previous.find(run.first);
+    const double ratio =
+        found == previous.end() ? kDefaultMaxRatio : found->second.max_ratio;
+    output << run.first << ' ' << static_cast<long long>(run.second.median_ns)
+           << ' ' << ratio << '\n';
+  }
+  return true;
+}
+
+std::string counter(const PerfCounters& counters, const Measurement& m,
+                    int event) {
+  if (!counters.Available(event)) return "n/a";
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.3g", m.counters[event]);
+  return buffer;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const bool update = argc == 3 && std::string(argv[1]) == "--update";
+  if (argc != 2 && !update) {
+    std::cerr << "usage: " << argv[0] << " [--update] <baseline>\n";
+    return 2;
+  }
+  const std::string path = argv[argc - 1];
+  const auto baseline = readBaseline(path);
+
+  // Пул запускается до открытия счётчиков, чтобы они охватили его потоки
+  S21ThreadPool::Instance();
+  PerfCounters counters;
+
+  std::printf("%-22s %12s %10s %12s %7s %10s %10s %10s %10s  %s\n",
+              "workload", "median_ms", "mad_ms", "baseline_ms", "ratio",
+              "cycles", "instr", "llc_miss", "dtlb_miss", "status");
+  std::vector<std::pair<std::string, Measurement>> runs;
+  int regressions = 0;
+  for (const Workload& workload : workloads()) {
+    const Measurement m = measure(workload, counters);
+    runs.emplace_back(workload.name, m);
+    std::string status = "new";
+    double base_ms = 0.0, ratio = 0.0;
+    auto found = baseline.find(workload.name);
+    if (found != baseline.end() && found->second.median_ns > 0) {
+      const Baseline& base = found->second;
+      base_ms = base.median_ns / 1e6;
+      ratio = m.median_ns / base.median_ns;
+      const bool slower = ratio > base.max_ratio &&
+                          m.median_ns - 3.0 * m.mad_ns > base.median_ns;
+      status = slower ? "REGRESSION" : "ok";
+      if (slower && !update) ++regressions;
+    }
+    std::printf("%-22s %12.3f %10.3f %12.3f %7.2f %10s %10s %10s %10s  %s\n",
+                workload.name.c_str(), m.median_ns / 1e6, m.mad_ns / 1e6,
+                base_ms, ratio, counter(counters, m, 0).c_str(),
+                counter(counters, m, 1).c_str(),
+                counter(counters, m, 2).c_str(),
+                counter(counters, m, 3).c_str(), status.c_str());
+  }
+
+  std::printf("\nhuge pages %s: relative to regular pages\n",
+              huge_backed ? "in use" : "unavailable");
+  for (const auto& run : runs) {
+    const std::string& name = run.first;
+    const std::string suffix = "_huge";
+    if (name.size() <= suffix.size() ||
+        name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+      continue;
+    }
+    const std::string plain = name.substr(0, name.size() - suffix.size());
+    auto found = std::find_if(runs.begin(), runs.end(),
+                              [&](const auto& other) {
+                                return other.first == plain;
+                              });
+    if (found == runs.end()) continue;
+    const Measurement& huge = run.second;
+    const Measurement& regular = found->second;
+    std::string dtlb = "n/a";
+    if (counters.Available(3) && regular.counters[3] > 0) {
+      char buffer[32];
+      std::snprintf(buffer, sizeof(buffer), "%.3f",
+                    huge.counters[3] / regular.counters[3]);
+      dtlb = buffer;
+    }
+    std::printf("%-22s time %.3f  dtlb_miss %s\n", name.c_str(),
+                huge.median_ns / regular.median_ns, dtlb.c_str());
+  }
+
+  if (update) {
+    if (!writeBaseline(path, runs, baseline)) {
+      std::cerr << "cannot write " << path << '\n';
+      return 2;
+    }
+    std::printf("baseline written to %s\n", path.c_str());
+    return 0;
+  }
+  if (regressions > 0) {
+    std::printf("%d performance regression(s)\n", regressions);
+    return 1;
+  }
+  return 0;
+}
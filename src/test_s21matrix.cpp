@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
 
 #include "./Matrix+/s21_matrix.h"
+#include "./Matrix+/s21_structured_matrix.h"
+#include "./Matrix+/s21_task_graph.h"
+#include "./Matrix+/s21_thread_pool.h"
 
 TEST(S21MatrixTest, DefaultConstructor) {
   S21Matrix matrix;
@@ -40,6 +50,185 @@ TEST(S21MatrixTest, ConstructorWithNegativeDimensions) {
   EXPECT_TRUE(exceptionThrown) << "Expected std::invalid_argument";
 }
 
+TEST(S21MatrixTest, ConstructorWithMemoryPolicy) {
+  S21Matrix interleaved(300, 200, S21MemoryPolicy::kInterleave);
+  S21Matrix bound(3, 4, S21MemoryPolicy::kBind, 0);
+  S21Matrix first_touch(3, 4, S21MemoryPolicy::kFirstTouch);
+
+  interleaved(299, 199) = 1.0;
+  EXPECT_DOUBLE_EQ(interleaved(299, 199), 1.0);
+  EXPECT_DOUBLE_EQ(interleaved(0, 0), 0.0);
+  EXPECT_TRUE(bound == first_touch);
+  EXPECT_THROW(S21Matrix(3, 4, S21MemoryPolicy::kBind, S21Numa::NodeCount()),
+               std::out_of_range);
+  EXPECT_THROW(S21Matrix(0, 4, S21MemoryPolicy::kInterleave),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, NumaTopology) {
+  ASSERT_GE(S21Numa::NodeCount(), 1);
+  std::vector<int> cpus = S21Numa::CpusByNode();
+  ASSERT_FALSE(cpus.empty());
+  EXPECT_EQ(S21Numa::NodeOfCpu(cpus.front()), 0);
+  EXPECT_EQ(S21Numa::NodeOfCpu(-1), -1);
+  EXPECT_FALSE(S21Numa::NodeCpus(0).empty());
+}
+
+TEST(S21MatrixTest, NumaThreadPolicyRestored) {
+  const S21Numa::ThreadPolicy saved = S21Numa::GetThreadPolicy();
+  const bool applied = S21Numa::SetThreadPolicy(S21MemoryPolicy::kBind, 0);
+  if (applied) S21Numa::RestoreThreadPolicy(saved);
+  const S21Numa::ThreadPolicy restored = S21Numa::GetThreadPolicy();
+  EXPECT_EQ(restored.valid, saved.valid);
+  EXPECT_EQ(restored.mode, saved.mode);
+  EXPECT_EQ(restored.nodes, saved.nodes);
+
+  S21Matrix bound(300, 200, S21MemoryPolicy::kBind, 0);
+  bound(1, 2) = 3.0;
+  S21Matrix copy = bound;
+  S21Matrix transposed = bound.Transpose();
+  transposed(2, 1) = 4.0;
+  EXPECT_DOUBLE_EQ(copy(1, 2), 3.0);
+  EXPECT_DOUBLE_EQ(bound(1, 2), 3.0);
+  EXPECT_EQ(S21Numa::GetThreadPolicy().mode, saved.mode);
+}
+
+TEST(S21MatrixTest, MemoryPolicyPlacesRows) {
+  const auto mode_of = [](const void* address) {
+    int mode = -1;
+    syscall(SYS_get_mempolicy, &mode, nullptr, 0, address, MPOL_F_ADDR);
+    return mode;
+  };
+  S21Matrix bound(300, 200, S21MemoryPolicy::kBind, 0);
+  bound.SetRows(301);
+  bound.SetCols(400);
+  bound(300, 399) = 1.0;
+  const S21Matrix copy = bound;
+  const std::vector<const double*> addresses = {
+      &bound(0, 0), &bound(150, 399), &bound(300, 399), &copy(299, 0)};
+  for (const double* address : addresses) {
+    EXPECT_EQ(mode_of(address), MPOL_BIND);
+    EXPECT_EQ(S21Numa::NodeOfAddress(address), 0);
+  }
+
+  S21Matrix interleaved(300, 200, S21MemoryPolicy::kInterleave);
+  interleaved.AppendRow(std::vector<double>(200, 1.0));
+  EXPECT_EQ(mode_of(&interleaved(0, 0)), MPOL_INTERLEAVE);
+  EXPECT_EQ(mode_of(&interleaved(300, 199)), MPOL_INTERLEAVE);
+  EXPECT_GE(S21Numa::NodeOfAddress(&interleaved(300, 199)), 0);
+}
+
+TEST(S21MatrixTest, ParallelForPinnedKeepsPartsOnWorkers) {
+  S21ThreadPool pool(4);
+  std::vector<std::thread::id> first(4), second(4);
+  for (auto* owners : {&first, &second}) {
+    pool.ParallelForPinned(0, 4, 1 << 20, [owners](int from, int to) {
+      for (int i = from; i < to; ++i) {
+        (*owners)[i] = std::this_thread::get_id();
+      }
+    });
+  }
+  EXPECT_EQ(first, second);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_NE(first[i], std::this_thread::get_id());
+    for (int j = 0; j < i; ++j) EXPECT_NE(first[i], first[j]);
+  }
+  EXPECT_THROW(pool.ParallelForPinned(0, 4, 1 << 20,
+                                      [](int, int) {
+                                        throw std::runtime_error("part");
+                                      }),
+               std::runtime_error);
+}
+
+TEST(S21MatrixTest, HugePageStorage) {
+  S21Matrix plain(300, 301);
+  S21Matrix huge(300, 301, S21PagePolicy::kTransparentHuge);
+  S21Matrix hugetlb(4, 5, S21PagePolicy::kHugeTlb);
+  for (int i = 0; i < 300; ++i)
+    for (int j = 0; j < 301; ++j) plain(i, j) = huge(i, j) = i - 0.5 * j;
+
+  EXPECT_EQ(huge.PagePolicy(), S21PagePolicy::kTransparentHuge);
+  EXPECT_EQ(hugetlb.PagePolicy(), S21PagePolicy::kHugeTlb);
+  EXPECT_EQ(plain.PagePolicy(), S21PagePolicy::kDefault);
+  EXPECT_FALSE(plain.HugePages());
+  EXPECT_DOUBLE_EQ(hugetlb(3, 4), 0.0);
+  for (int i = 0; i < 300; ++i)
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&huge(i, 0)) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&plain(7, 0)) % 64, 0u);
+
+  S21Matrix copy = huge;
+  huge.SetCols(400);
+  huge.AppendRow(std::vector<double>(400, 1.0));
+  EXPECT_EQ(copy.PagePolicy(), S21PagePolicy::kTransparentHuge);
+  EXPECT_TRUE(copy == plain);
+  EXPECT_DOUBLE_EQ(huge(299, 300), plain(299, 300));
+  EXPECT_DOUBLE_EQ(huge(300, 399), 1.0);
+
+  S21Matrix transposed = huge.Transpose();
+  transposed.Materialize();
+  EXPECT_EQ(transposed.PagePolicy(), S21PagePolicy::kTransparentHuge);
+  EXPECT_TRUE((plain + copy).EqMatrix(plain * 2.0));
+}
+
+TEST(S21MatrixTest, PageArenaReusesMemory) {
+  const S21PagePolicy policy = S21PagePolicy::kTransparentHuge;
+  void* first = nullptr;
+  {
+    S21PageArena arena(policy);
+    first = arena.Allocate(1 << 20);
+  }
+  S21PageArena again(policy);
+  EXPECT_EQ(again.Allocate(1 << 20), first);
+
+  using Row = std::vector<double, S21AlignedAllocator<double>>;
+  auto arena = std::make_shared<S21PageArena>(policy);
+  const S21AlignedAllocator<double> allocator(arena);
+  std::vector<Row> rows;
+  for (int i = 0; i < 300; ++i) rows.emplace_back(301, i, allocator);
+  const size_t peak = rows.size() * 2000 * sizeof(double);
+  for (int i = 0; i < 20; ++i) {
+    for (auto& row : rows) {
+      row.resize(2000, 1.0);
+      row.shrink_to_fit();
+    }
+    EXPECT_LE(arena->MappedBytes(), 3 * peak);
+    for (auto& row : rows) {
+      row.resize(301);
+      row.shrink_to_fit();
+    }
+  }
+  EXPECT_DOUBLE_EQ(rows[299][300], 299.0);
+  rows.clear();
+  const size_t mapped = arena->MappedBytes();
+  for (int i = 0; i < 1000; ++i) {
+    Row row(allocator);
+    row.reserve(1000 + i);
+  }
+  EXPECT_EQ(arena->MappedBytes(), mapped);
+}
+
+TEST(S21MatrixTest, PageArenaCacheKeepsPlacement) {
+  const auto mode_of = [](const void* address) {
+    int mode = -1;
+    syscall(SYS_get_mempolicy, &mode, nullptr, 0, address, MPOL_F_ADDR);
+    return mode;
+  };
+  const S21PagePolicy policy = S21PagePolicy::kTransparentHuge;
+  void* first = nullptr;
+  {
+    S21PageArena bound(policy, S21MemoryPolicy::kBind, 0);
+    first = bound.Allocate(1 << 20);
+    static_cast<double*>(first)[0] = 1.0;
+  }
+  S21PageArena touched(policy);
+  void* other = touched.Allocate(1 << 20);
+  EXPECT_NE(other, first);
+  EXPECT_EQ(mode_of(other), MPOL_DEFAULT);
+  S21PageArena again(policy, S21MemoryPolicy::kBind, 0);
+  EXPECT_EQ(again.Allocate(1 << 20), first);
+  EXPECT_EQ(mode_of(first), MPOL_BIND);
+}
+
 TEST(S21MatrixTest, CopyConstructor) {
   S21Matrix matrix1(2, 2);
   matrix1.SetElement(0, 0, 1.0);
@@ -161,6 +350,65 @@ TEST(S21MatrixTest, SetDimensionsInvalid) {
   EXPECT_THROW(matrix.SetDimensions(-1, -1), std::invalid_argument);
 }
 
+TEST(S21MatrixTest, ResizeEmptyMatrix) {
+  S21Matrix empty;
+  EXPECT_THROW(empty.SetRows(3), std::invalid_argument);
+  EXPECT_THROW(empty.SetCols(3), std::invalid_argument);
+
+  S21Matrix source(2, 2);
+  S21Matrix target(std::move(source));
+  EXPECT_THROW(source.SetCols(3), std::invalid_argument);
+  EXPECT_THROW(source.SetDimensions(2, 2), std::invalid_argument);
+  EXPECT_EQ(source.getRows(), 0);
+}
+
+TEST(S21MatrixTest, SetColsShrinkThenGrow) {
+  S21Matrix matrix(2, 3);
+  matrix(0, 2) = 5.0;
+  matrix(1, 0) = 1.0;
+
+  matrix.SetCols(2);
+  matrix.SetCols(3);
+
+  EXPECT_DOUBLE_EQ(matrix(0, 2), 0.0);
+  EXPECT_DOUBLE_EQ(matrix(1, 0), 1.0);
+  EXPECT_THROW(matrix.SetCols(0), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, AppendRow) {
+  S21Matrix matrix;
+  matrix.Reserve(100, 3);
+  for (int i = 0; i < 100; ++i) matrix.AppendRow({1.0 * i, 2.0 * i, 3.0 * i});
+
+  EXPECT_EQ(matrix.getRows(), 100);
+  EXPECT_EQ(matrix.getCols(), 3);
+  EXPECT_DOUBLE_EQ(matrix(99, 2), 297.0);
+
+  matrix.SetRows(101);
+  EXPECT_DOUBLE_EQ(matrix(100, 1), 0.0);
+}
+
+TEST(S21MatrixTest, AppendRowTransposed) {
+  S21Matrix matrix(2, 1);
+  matrix(1, 0) = 4.0;
+  S21Matrix transposed = matrix.Transpose();
+  double row[2] = {5.0, 6.0};
+
+  transposed.AppendRow(row, 2);
+
+  EXPECT_EQ(transposed.getRows(), 2);
+  EXPECT_DOUBLE_EQ(transposed(0, 1), 4.0);
+  EXPECT_DOUBLE_EQ(transposed(1, 1), 6.0);
+  EXPECT_EQ(matrix.getRows(), 2);
+}
+
+TEST(S21MatrixTest, AppendRowInvalid) {
+  S21Matrix matrix(2, 2);
+  EXPECT_THROW(matrix.AppendRow({1.0}), std::invalid_argument);
+  EXPECT_THROW(matrix.AppendRow(std::vector<double>()), std::invalid_argument);
+  EXPECT_THROW(matrix.Reserve(0, 2), std::invalid_argument);
+}
+
 TEST(S21MatrixTest, SetElement) {
   S21Matrix matrix(2, 2);
   matrix.SetElement(0, 0, 1.0);
@@ -255,6 +503,95 @@ TEST(S21MatrixTest, Transpose) {
   EXPECT_DOUBLE_EQ(transposed.getElement(2, 1), 6.0);
 }
 
+TEST(S21MatrixTest, TransposeIsLazy) {
+  S21Matrix matrix(2, 3);
+  matrix(0, 2) = 3.0;
+
+  S21Matrix transposed = matrix.Transpose();
+  EXPECT_TRUE(transposed.IsTransposed());
+  EXPECT_EQ(transposed.getRows(), 3);
+  EXPECT_EQ(transposed.getCols(), 2);
+  EXPECT_DOUBLE_EQ(transposed(2, 0), 3.0);
+
+  matrix(0, 2) = 5.0;
+  transposed(1, 1) = 7.0;
+  EXPECT_DOUBLE_EQ(transposed(2, 0), 3.0);
+  EXPECT_DOUBLE_EQ(matrix(1, 1), 0.0);
+
+  S21Matrix twice = transposed.Transpose();
+  EXPECT_FALSE(twice.IsTransposed());
+  EXPECT_DOUBLE_EQ(twice(1, 1), 7.0);
+}
+
+TEST(S21MatrixTest, TransposeSharesWrittenMatrix) {
+  S21Matrix matrix(300, 200);
+  for (int i = 0; i < 300; ++i)
+    for (int j = 0; j < 200; ++j) matrix(i, j) = i + 0.5 * j;
+
+  const S21Matrix transposed = matrix.Transpose();
+  const S21Matrix& source = matrix;
+  EXPECT_EQ(&transposed(7, 3), &source(3, 7));
+
+  matrix(3, 7) = -1.0;
+  EXPECT_DOUBLE_EQ(transposed(7, 3), 3 + 0.5 * 7);
+  EXPECT_NE(&transposed(7, 3), &source(3, 7));
+}
+
+TEST(S21MatrixTest, TransposeMaterialize) {
+  S21Matrix matrix(2, 3);
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 3; ++j) matrix(i, j) = i * 3 + j;
+
+  S21Matrix transposed = matrix.Transpose();
+  transposed.Materialize();
+
+  EXPECT_FALSE(transposed.IsTransposed());
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_DOUBLE_EQ(transposed(j, i), matrix(i, j));
+}
+
+TEST(S21MatrixTest, TransposeMulMatrixLayouts) {
+  S21Matrix a(3, 4), b(4, 2), a_t(4, 3), b_t(2, 4);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 4; ++j) a_t(j, i) = a(i, j) = i - 2.0 * j;
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 2; ++j) b_t(j, i) = b(i, j) = i * j + 1.0;
+  S21Matrix expected = a * b;
+
+  EXPECT_TRUE(a_t.Transpose() * b == expected);
+  EXPECT_TRUE(a * b_t.Transpose() == expected);
+  S21Matrix both = a_t.Transpose() * b_t.Transpose();
+  EXPECT_TRUE(both.IsTransposed());
+  EXPECT_TRUE(both == expected);
+}
+
+TEST(S21MatrixTest, TransposeElementwise) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 1) = 1.0;
+  matrix(1, 0) = 2.0;
+
+  S21Matrix sum = matrix + matrix.Transpose();
+  matrix -= matrix.Transpose();
+
+  EXPECT_DOUBLE_EQ(sum(0, 1), 3.0);
+  EXPECT_DOUBLE_EQ(sum(1, 0), 3.0);
+  EXPECT_DOUBLE_EQ(matrix(0, 1), -1.0);
+  EXPECT_DOUBLE_EQ(matrix(1, 0), 1.0);
+}
+
+TEST(S21MatrixTest, TransposeSetRows) {
+  S21Matrix matrix(2, 3);
+  matrix(0, 2) = 4.0;
+  S21Matrix transposed = matrix.Transpose();
+
+  transposed.SetRows(4);
+
+  EXPECT_FALSE(transposed.IsTransposed());
+  EXPECT_DOUBLE_EQ(transposed(2, 0), 4.0);
+  EXPECT_DOUBLE_EQ(transposed(3, 1), 0.0);
+}
+
 TEST(S21MatrixTest, Determinant2x2) {
   S21Matrix matrix(2, 2);
   matrix.SetElement(0, 0, 1.0);
@@ -297,6 +634,520 @@ TEST(S21MatrixTest, InverseMatrix) {
   EXPECT_NEAR(inverse.getElement(1, 1), 0.4, 1e-9);
 }
 
+TEST(S21MatrixTest, BadlyScaledNonsingular) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 1) = 1e10;
+  matrix(1, 0) = 1e-10;
+
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), -1.0);
+  S21Matrix inverse = matrix.InverseMatrix();
+  EXPECT_DOUBLE_EQ(inverse(0, 1), 1e10);
+  EXPECT_DOUBLE_EQ(inverse(1, 0), 1e-10);
+  EXPECT_DOUBLE_EQ(inverse(0, 0), 0.0);
+  S21Matrix complements = matrix.CalcComplements();
+  EXPECT_NEAR(complements(0, 0), 0.0, 1e-6);
+  EXPECT_NEAR(complements(0, 1), -1e-10, 1e-6);
+  EXPECT_DOUBLE_EQ(complements(1, 0), -1e10);
+  EXPECT_NEAR(complements(1, 1), 0.0, 1e-6);
+
+  S21Matrix singular(2, 2);
+  singular(0, 1) = 1.0;
+  EXPECT_DOUBLE_EQ(singular.Determinant(), 0.0);
+  EXPECT_THROW(singular.InverseMatrix(), std::runtime_error);
+}
+
+TEST(S21MatrixTest, CalcComplements) {
+  S21Matrix matrix(3, 3);
+  double values[3][3] = {{1, 2, 3}, {0, 4, 2}, {5, 2, 1}};
+  double expected[3][3] = {{0, 10, -20}, {4, -14, 8}, {-8, -2, 4}};
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) matrix(i, j) = values[i][j];
+
+  S21Matrix complements = matrix.CalcComplements();
+
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(complements(i, j), expected[i][j], 1e-9);
+}
+
+TEST(S21MatrixTest, CalcComplementsSingular) {
+  S21Matrix matrix(3, 3);
+  double expected[3][3] = {{-3, 6, -3}, {6, -12, 6}, {-3, 6, -3}};
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) matrix(i, j) = i * 3 + j + 1;
+
+  S21Matrix complements = matrix.CalcComplements();
+
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(complements(i, j), expected[i][j], 1e-9);
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), 0.0);
+  EXPECT_THROW(matrix.InverseMatrix(), std::runtime_error);
+}
+
+TEST(S21MatrixTest, CalcComplementsSingularOddPermutation) {
+  S21Matrix square(2, 2);
+  square(0, 0) = 2;
+  square(0, 1) = 4;
+  square(1, 0) = 1;
+  square(1, 1) = 2;
+  S21Matrix square_complements = square.CalcComplements();
+  EXPECT_DOUBLE_EQ(square_complements(0, 0), 2.0);
+  EXPECT_DOUBLE_EQ(square_complements(0, 1), -1.0);
+  EXPECT_DOUBLE_EQ(square_complements(1, 0), -4.0);
+  EXPECT_DOUBLE_EQ(square_complements(1, 1), 2.0);
+
+  S21Matrix nilpotent(2, 2);
+  nilpotent(0, 1) = 1;
+  EXPECT_DOUBLE_EQ(nilpotent.CalcComplements()(1, 0), -1.0);
+
+  S21Matrix matrix(3, 3);
+  double values[3][3] = {{1, 2, 9}, {2, 4, 18}, {0, 1, 1}};
+  double expected[3][3] = {{-14, -2, 2}, {7, 1, -1}, {0, 0, 0}};
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) matrix(i, j) = values[i][j];
+
+  S21Matrix complements = matrix.CalcComplements();
+
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_NEAR(complements(i, j), expected[i][j], 1e-9);
+}
+
+TEST(S21MatrixTest, CalcComplementsLowRank) {
+  S21Matrix matrix(3, 3);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j) matrix(i, j) = i + 1;
+
+  S21Matrix complements = matrix.CalcComplements();
+
+  EXPECT_TRUE(complements == S21Matrix(3, 3));
+}
+
+TEST(S21MatrixTest, CalcComplementsLarge) {
+  const int n = 120;
+  S21Matrix matrix(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      matrix(i, j) = (i == j ? 4.0 : 0.0) + std::sin(i * 0.37 + j * 1.3) * 0.5;
+  double det = matrix.Determinant();
+
+  S21Matrix check = matrix * matrix.CalcComplements().Transpose();
+
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      EXPECT_NEAR(check(i, j) / det, i == j ? 1.0 : 0.0, 1e-9);
+}
+
+TEST(S21MatrixTest, CalcComplementsNotSquare) {
+  S21Matrix matrix(2, 3);
+  EXPECT_THROW(matrix.CalcComplements(), std::invalid_argument);
+  EXPECT_THROW(matrix.InverseMatrix(), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, AsyncOperations) {
+  S21Matrix a(3, 3), b(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    a(i, i) = 2.0;
+    b(i, (i + 1) % 3) = 1.0;
+  }
+
+  std::future<S21Matrix> product = a.MulMatrixAsync(b);
+  std::future<S21Matrix> sum = a.SumMatrixAsync(b);
+  std::future<S21Matrix> difference = a.SubMatrixAsync(b);
+  std::future<S21Matrix> inverse = a.InverseMatrixAsync();
+  a(0, 0) = 100.0;
+
+  EXPECT_TRUE(product.get() == b * 2.0);
+  EXPECT_DOUBLE_EQ(sum.get()(0, 1), 1.0);
+  EXPECT_DOUBLE_EQ(difference.get()(0, 0), 2.0);
+  EXPECT_DOUBLE_EQ(inverse.get()(2, 2), 0.5);
+  EXPECT_THROW(a.MulMatrixAsync(S21Matrix(2, 2)), std::invalid_argument);
+  EXPECT_THROW(a.SumMatrixAsync(S21Matrix(2, 2)), std::invalid_argument);
+  EXPECT_THROW(a.SubMatrixAsync(S21Matrix(3, 2)), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(2, 3).InverseMatrixAsync(), std::invalid_argument);
+  std::future<S21Matrix> singular = S21Matrix(2, 2).InverseMatrixAsync();
+  EXPECT_THROW(singular.get(), std::runtime_error);
+}
+
+TEST(S21MatrixTest, TaskGraph) {
+  S21Matrix a(2, 2), b(2, 2);
+  a(0, 0) = 1.0;
+  a(0, 1) = 2.0;
+  a(1, 0) = 3.0;
+  a(1, 1) = 4.0;
+  b(0, 0) = 2.0;
+  b(1, 1) = 3.0;
+
+  S21TaskGraph graph;
+  auto in_a = graph.Input(a);
+  auto in_b = graph.Input(b);
+  auto ab = graph.Mul(in_a, in_b);
+  auto ba = graph.Mul(in_b, in_a);
+  auto sum = graph.Sum(ab, graph.Transpose(ba));
+  auto result = graph.Inverse(graph.Sub(sum, graph.MulNumber(in_a, 3.0)));
+  graph.Run();
+
+  S21Matrix expected = (a * b + (b * a).Transpose() - a * 3.0).InverseMatrix();
+  EXPECT_TRUE(graph.Result(result) == expected);
+  EXPECT_THROW(graph.Result(100), std::out_of_range);
+  EXPECT_THROW(graph.Sum(in_a, 100), std::out_of_range);
+}
+
+TEST(S21MatrixTest, TaskGraphError) {
+  S21TaskGraph graph;
+  auto singular = graph.Input(S21Matrix(2, 2));
+  auto inverse = graph.Inverse(singular);
+  graph.Sum(inverse, singular);
+
+  EXPECT_THROW(graph.Run(), std::runtime_error);
+}
+
+TEST(S21MatrixTest, Reductions) {
+  S21Matrix matrix(2, 3);
+  double values[2][3] = {{1, -2, 3}, {-4, 5, -6}};
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 3; ++j) matrix(i, j) = values[i][j];
+
+  EXPECT_DOUBLE_EQ(matrix.FrobeniusNorm(), std::sqrt(91.0));
+  EXPECT_DOUBLE_EQ(matrix.OneNorm(), 9.0);
+  EXPECT_DOUBLE_EQ(matrix.InfNorm(), 15.0);
+  EXPECT_DOUBLE_EQ(matrix.Min(), -6.0);
+  EXPECT_DOUBLE_EQ(matrix.Max(), 5.0);
+  S21Matrix row_sums = matrix.RowSums();
+  S21Matrix col_sums = matrix.ColSums();
+  EXPECT_EQ(row_sums.getRows(), 2);
+  EXPECT_DOUBLE_EQ(row_sums(1, 0), -5.0);
+  EXPECT_EQ(col_sums.getCols(), 3);
+  EXPECT_DOUBLE_EQ(col_sums(0, 2), -3.0);
+
+  S21Matrix transposed = matrix.Transpose();
+  EXPECT_DOUBLE_EQ(transposed.OneNorm(), 15.0);
+  EXPECT_DOUBLE_EQ(transposed.InfNorm(), 9.0);
+  EXPECT_DOUBLE_EQ(transposed.RowSums()(2, 0), -3.0);
+  EXPECT_DOUBLE_EQ(transposed.ColSums()(0, 1), -5.0);
+}
+
+TEST(S21MatrixTest, ReductionsLarge) {
+  S21Matrix matrix(300, 301);
+  for (int i = 0; i < 300; ++i)
+    for (int j = 0; j < 301; ++j) matrix(i, j) = (i + j) % 7 - 3.0;
+
+  S21Matrix shifted = matrix;
+  shifted(150, 200) += 0.5;
+
+  EXPECT_DOUBLE_EQ(matrix.Max(), 3.0);
+  EXPECT_DOUBLE_EQ(matrix.MaxAbsDiff(shifted), 0.5);
+  EXPECT_DOUBLE_EQ(matrix.MaxAbsDiff(shifted.Transpose().Transpose()), 0.5);
+  EXPECT_FALSE(matrix.EqMatrix(shifted));
+  EXPECT_TRUE(matrix.EqMatrix(shifted, 0.5, 0.0));
+
+  shifted *= 1.0 / 3.0;
+  const double norm = shifted.FrobeniusNorm();
+  const double sum = shifted.ColSums().RowSums()(0, 0);
+  for (int run = 0; run < 20; ++run) {
+    EXPECT_EQ(shifted.FrobeniusNorm(), norm);
+    EXPECT_EQ(shifted.ColSums().RowSums()(0, 0), sum);
+  }
+}
+
+TEST(S21MatrixTest, Trace) {
+  S21Matrix matrix(3, 3);
+  for (int i = 0; i < 3; ++i) matrix(i, i) = i + 1.0;
+  EXPECT_DOUBLE_EQ(matrix.Trace(), 6.0);
+  EXPECT_THROW(S21Matrix(2, 3).Trace(), std::invalid_argument);
+  EXPECT_THROW(S21Matrix().Min(), std::invalid_argument);
+  EXPECT_DOUBLE_EQ(S21Matrix().InfNorm(), 0.0);
+}
+
+TEST(S21MatrixTest, EqMatrixRelativeTolerance) {
+  S21Matrix a(1, 2), b(1, 2);
+  a(0, 0) = 1e9;
+  b(0, 0) = 1e9 + 1.0;
+  a(0, 1) = b(0, 1) = 1.0;
+
+  EXPECT_FALSE(a.EqMatrix(b));
+  EXPECT_TRUE(a.EqMatrix(b, 0.0, 1e-8));
+  EXPECT_FALSE(a.EqMatrix(b, 0.0, 1e-10));
+  EXPECT_FALSE(a.EqMatrix(S21Matrix(2, 1), 1.0, 1.0));
+}
+
+S21Matrix diagonal(const S21Matrix& values) {
+  S21Matrix result(values.getRows(), values.getRows());
+  for (int i = 0; i < values.getRows(); ++i) result(i, i) = values(i, 0);
+  return result;
+}
+
+S21Matrix identity(int size) {
+  S21Matrix result(size, size);
+  for (int i = 0; i < size; ++i) result(i, i) = 1.0;
+  return result;
+}
+
+TEST(S21MatrixTest, SymmetricEigenSmall) {
+  S21Matrix matrix(2, 2);
+  matrix(0, 0) = matrix(1, 1) = 2.0;
+  matrix(0, 1) = matrix(1, 0) = 1.0;
+
+  S21EigenDecomposition eigen = matrix.SymmetricEigen();
+
+  EXPECT_NEAR(eigen.values(0, 0), 1.0, 1e-12);
+  EXPECT_NEAR(eigen.values(1, 0), 3.0, 1e-12);
+  EXPECT_NEAR(std::abs(eigen.vectors(0, 1)), std::sqrt(0.5), 1e-12);
+  EXPECT_THROW(S21Matrix(2, 3).SymmetricEigen(), std::invalid_argument);
+  EXPECT_THROW(S21Matrix().SymmetricEigen(), std::invalid_argument);
+  matrix(0, 1) = 5.0;
+  EXPECT_THROW(matrix.SymmetricEigen(), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, SymmetricEigenLarge) {
+  const int n = 101;
+  S21Matrix matrix(n, n);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j <= i; ++j)
+      matrix(i, j) = matrix(j, i) = std::sin(i * 0.9 + j * 1.7) + (i == j);
+
+  S21EigenDecomposition eigen = matrix.SymmetricEigen();
+
+  S21Matrix vectors = eigen.vectors;
+  EXPECT_TRUE((vectors.Transpose() * vectors).EqMatrix(identity(n), 1e-10, 0));
+  EXPECT_TRUE((matrix * vectors).EqMatrix(vectors * diagonal(eigen.values),
+                                          1e-9, 0));
+  for (int i = 1; i < n; ++i)
+    EXPECT_LE(eigen.values(i - 1, 0), eigen.values(i, 0));
+}
+
+TEST(S21MatrixTest, SVDTallAndWide) {
+  for (auto dims : {std::make_pair(120, 70), std::make_pair(50, 90),
+                    std::make_pair(3, 3)}) {
+    S21Matrix matrix(dims.first, dims.second);
+    for (int i = 0; i < dims.first; ++i)
+      for (int j = 0; j < dims.second; ++j)
+        matrix(i, j) = std::cos(i * 1.1 - j * 0.4) + 0.01 * i;
+
+    S21SingularValueDecomposition svd = matrix.SVD();
+
+    const int k = std::min(dims.first, dims.second);
+    S21Matrix u = svd.u, v = svd.v;
+    EXPECT_EQ(u.getCols(), k);
+    EXPECT_EQ(v.getRows(), dims.second);
+    EXPECT_TRUE((u.Transpose() * u).EqMatrix(identity(k), 1e-10, 0));
+    EXPECT_TRUE((v.Transpose() * v).EqMatrix(identity(k), 1e-10, 0));
+    EXPECT_TRUE(
+        (u * diagonal(svd.values) * v.Transpose()).EqMatrix(matrix, 1e-9, 0));
+    for (int i = 1; i < k; ++i)
+      EXPECT_GE(svd.values(i - 1, 0), svd.values(i, 0));
+  }
+}
+
+TEST(S21MatrixTest, SVDRankDeficient) {
+  S21Matrix matrix(4, 3);
+  for (int i = 0; i < 4; ++i)
+    for (int j = 0; j < 3; ++j) matrix(i, j) = (i + 1) * (j + 2);
+
+  S21SingularValueDecomposition svd = matrix.SVD();
+
+  EXPECT_NEAR(svd.values(0, 0), matrix.FrobeniusNorm(), 1e-10);
+  EXPECT_NEAR(svd.values(1, 0), 0.0, 1e-10);
+  EXPECT_NEAR(svd.values(2, 0), 0.0, 1e-10);
+}
+
+TEST(S21MatrixTest, TruncatedSVD) {
+  const int m = 200, n = 150, rank = 5;
+  S21Matrix left(m, rank), right(rank, n);
+  for (int i = 0; i < m; ++i)
+    for (int j = 0; j < rank; ++j) left(i, j) = std::sin(i * 0.3 + j);
+  for (int i = 0; i < rank; ++i)
+    for (int j = 0; j < n; ++j) right(i, j) = std::cos(j * 0.7 - i) * (i + 1);
+  S21Matrix matrix = left * right;
+
+  S21SingularValueDecomposition full = matrix.SVD();
+  S21SingularValueDecomposition top = matrix.TruncatedSVD(3);
+
+  EXPECT_EQ(top.u.getCols(), 3);
+  EXPECT_EQ(top.v.getCols(), 3);
+  EXPECT_EQ(top.values.getRows(), 3);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_NEAR(top.values(i, 0), full.values(i, 0), 1e-8 * full.values(0, 0));
+  EXPECT_THROW(matrix.TruncatedSVD(0), std::invalid_argument);
+  EXPECT_THROW(matrix.TruncatedSVD(151), std::invalid_argument);
+}
+
+S21Matrix sample(int rows, int cols, double seed) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i)
+    for (int j = 0; j < cols; ++j)
+      result(i, j) = std::sin(seed + i * 0.7 + j * 1.3) + (i == j ? 4.0 : 0.0);
+  return result;
+}
+
+TEST(S21MatrixTest, TriangularMatrix) {
+  S21Matrix dense = sample(40, 40, 1.0);
+  S21Matrix rhs = sample(40, 7, 2.0);
+  for (S21Triangle triangle : {S21Triangle::kLower, S21Triangle::kUpper}) {
+    S21TriangularMatrix t = S21TriangularMatrix::FromMatrix(dense, triangle);
+    S21Matrix full = t.ToMatrix();
+
+    EXPECT_NEAR(t.Determinant(), full.Determinant(),
+                1e-9 * std::abs(t.Determinant()));
+    EXPECT_TRUE(t.MulMatrix(rhs).EqMatrix(full * rhs, 1e-12, 1e-12));
+    EXPECT_TRUE((full * t.Solve(rhs)).EqMatrix(rhs, 1e-10, 0));
+    EXPECT_TRUE(
+        (full * t.Solve(rhs.Transpose().Transpose())).EqMatrix(rhs, 1e-10, 0));
+  }
+  S21TriangularMatrix lower(3, S21Triangle::kLower);
+  lower.SetElement(2, 0, 5.0);
+  EXPECT_DOUBLE_EQ(lower.getElement(2, 0), 5.0);
+  EXPECT_DOUBLE_EQ(lower.getElement(0, 2), 0.0);
+  EXPECT_THROW(lower.SetElement(0, 2, 1.0), std::out_of_range);
+  EXPECT_THROW(lower.Solve(S21Matrix(3, 1)), std::runtime_error);
+  EXPECT_THROW(lower.MulMatrix(S21Matrix(2, 1)), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, SymmetricMatrix) {
+  S21Matrix a = sample(30, 12, 3.0);
+  S21Matrix b = sample(30, 5, 4.0);
+  S21SymmetricMatrix s(30);
+  for (int i = 0; i < 30; ++i) s.SetElement(i, i, 1.0);
+  s.RankKUpdate(a, 2.0, 3.0);
+  S21Matrix expected = a * a.Transpose() * 2.0 + identity(30) * 3.0;
+
+  EXPECT_TRUE(s.ToMatrix().EqMatrix(expected, 1e-12, 1e-12));
+  EXPECT_DOUBLE_EQ(s.getElement(3, 17), s.getElement(17, 3));
+  EXPECT_TRUE(s.MulMatrix(b).EqMatrix(expected * b, 1e-10, 1e-12));
+  EXPECT_TRUE(S21SymmetricMatrix::FromMatrix(expected).ToMatrix().EqMatrix(
+      expected, 0.0, 0.0));
+  EXPECT_THROW(S21SymmetricMatrix::FromMatrix(a), std::invalid_argument);
+  EXPECT_THROW(S21SymmetricMatrix::FromMatrix(sample(3, 3, 0.0)),
+               std::invalid_argument);
+}
+
+TEST(S21MatrixTest, BandMatrix) {
+  S21Matrix dense = sample(25, 20, 5.0);
+  S21Matrix b = sample(20, 6, 6.0);
+  S21BandMatrix band = S21BandMatrix::FromMatrix(dense, 2, 1);
+  S21Matrix full = band.ToMatrix();
+
+  EXPECT_DOUBLE_EQ(full(5, 3), dense(5, 3));
+  EXPECT_DOUBLE_EQ(full(5, 7), 0.0);
+  EXPECT_DOUBLE_EQ(band.getElement(5, 2), 0.0);
+  EXPECT_TRUE(band.MulMatrix(b).EqMatrix(full * b, 1e-12, 1e-12));
+  EXPECT_THROW(band.SetElement(0, 5, 1.0), std::out_of_range);
+  EXPECT_THROW(S21BandMatrix(3, 3, -1, 0), std::invalid_argument);
+  EXPECT_THROW(band.MulMatrix(b.Transpose()), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, DeterminantTriangular) {
+  S21Matrix upper = S21TriangularMatrix::FromMatrix(sample(6, 6, 7.0),
+                                                    S21Triangle::kUpper)
+                        .ToMatrix();
+  double product = 1.0;
+  for (int i = 0; i < 6; ++i) product *= upper(i, i);
+
+  EXPECT_DOUBLE_EQ(upper.Determinant(), product);
+  EXPECT_DOUBLE_EQ(upper.Transpose().Determinant(), product);
+  upper(5, 5) = 0.0;
+  EXPECT_DOUBLE_EQ(upper.Determinant(), 0.0);
+  EXPECT_DOUBLE_EQ(S21Matrix().Determinant(), 0.0);
+}
+
+TEST(S21MatrixTest, Pow) {
+  S21Matrix matrix = sample(5, 5, 8.0) * 0.3;
+  S21Matrix expected = identity(5);
+  for (int i = 0; i < 7; ++i) expected *= matrix;
+
+  EXPECT_TRUE(matrix.Pow(7).EqMatrix(expected, 1e-12, 1e-12));
+  EXPECT_TRUE(matrix.Transpose().Pow(7).EqMatrix(expected.Transpose(), 1e-12,
+                                                 1e-12));
+  EXPECT_TRUE(matrix.Pow(0).EqMatrix(identity(5), 0.0, 0.0));
+  EXPECT_TRUE(matrix.Pow(1).EqMatrix(matrix, 0.0, 0.0));
+  EXPECT_TRUE((matrix.Pow(-3) * matrix.Pow(3)).EqMatrix(identity(5), 1e-10, 0));
+  EXPECT_THROW(S21Matrix(2, 3).Pow(2), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, PowLargeExponent) {
+  const double angle = 0.001;
+  S21Matrix rotation(2, 2);
+  rotation(0, 0) = rotation(1, 1) = std::cos(angle);
+  rotation(1, 0) = std::sin(angle);
+  rotation(0, 1) = -rotation(1, 0);
+
+  S21Matrix power = rotation.Pow(1000000);
+
+  EXPECT_NEAR(power(0, 0), std::cos(1000.0), 1e-9);
+  EXPECT_NEAR(power(1, 0), std::sin(1000.0), 1e-9);
+}
+
+TEST(S21MatrixTest, Exp) {
+  S21Matrix generator(2, 2);
+  generator(0, 1) = -3.0;
+  generator(1, 0) = 3.0;
+  S21Matrix rotation = generator.Exp();
+  EXPECT_NEAR(rotation(0, 0), std::cos(3.0), 1e-14);
+  EXPECT_NEAR(rotation(1, 0), std::sin(3.0), 1e-14);
+
+  S21Matrix nilpotent(2, 2);
+  nilpotent(0, 1) = 5.0;
+  EXPECT_TRUE(nilpotent.Exp().EqMatrix(identity(2) + nilpotent, 1e-14, 0));
+
+  S21Matrix values(3, 1);
+  values(0, 0) = -2.0;
+  values(1, 0) = 0.0;
+  values(2, 0) = 10.0;
+  S21Matrix exponent = diagonal(values).Exp();
+  for (int i = 0; i < 3; ++i)
+    EXPECT_NEAR(exponent(i, i), std::exp(values(i, 0)),
+                1e-14 * std::exp(values(i, 0)));
+
+  S21Matrix matrix = sample(20, 20, 9.0);
+  EXPECT_TRUE((matrix.Exp() * (matrix * -1.0).Exp())
+                  .EqMatrix(identity(20), 1e-8, 0));
+  EXPECT_TRUE(S21Matrix(3, 3).Exp().EqMatrix(identity(3), 0.0, 0.0));
+  EXPECT_THROW(S21Matrix(2, 3).Exp(), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, ParseCSV) {
+  S21Matrix matrix = S21Matrix::ParseCSV("1, -2.5,3e2\r\n\n +4,5,6\n");
+  EXPECT_EQ(matrix.getRows(), 2);
+  EXPECT_EQ(matrix.getCols(), 3);
+  EXPECT_DOUBLE_EQ(matrix(0, 1), -2.5);
+  EXPECT_DOUBLE_EQ(matrix(0, 2), 300.0);
+  EXPECT_DOUBLE_EQ(matrix(1, 0), 4.0);
+
+  S21Matrix spaced = S21Matrix::ParseCSV("1  -2.5\t300\n4 5 6", ' ');
+  EXPECT_TRUE(spaced.EqMatrix(matrix, 0.0, 0.0));
+  S21Matrix tabbed = S21Matrix::ParseCSV("1\t -2.5\t3e2\n+4 \t5\t6\n", '\t');
+  EXPECT_TRUE(tabbed.EqMatrix(matrix, 0.0, 0.0));
+  EXPECT_THROW(S21Matrix::ParseCSV("1\t\t2\n", '\t'), std::invalid_argument);
+
+  EXPECT_THROW(S21Matrix::ParseCSV("1,+-2\n"), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::ParseCSV("++1,2\n"), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::ParseCSV("1,2\n3\n"), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::ParseCSV("1,2\n3,4,5\n"), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::ParseCSV("1,x\n"), std::invalid_argument);
+  EXPECT_THROW(S21Matrix::ParseCSV(" \n\n"), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, CSVRoundTrip) {
+  S21Matrix matrix = sample(3000, 11, 10.0) * 1e-3;
+  matrix(2999, 10) = -1e300;
+  const std::string path = ::testing::TempDir() + "s21_matrix_test.csv";
+
+  matrix.Transpose().ToCSV(path, ';');
+  S21Matrix mapped = S21Matrix::FromCSV(path, ';');
+  S21Matrix read = S21Matrix::FromCSV(path, ';', S21FileMode::kRead);
+  std::remove(path.c_str());
+
+  EXPECT_TRUE(mapped.EqMatrix(matrix.Transpose(), 0.0, 0.0));
+  EXPECT_TRUE(read.EqMatrix(mapped, 0.0, 0.0));
+  std::ostringstream text;
+  matrix.ToCSV(text, ' ');
+  EXPECT_TRUE(S21Matrix::ParseCSV(text.str(), ' ').EqMatrix(matrix, 0.0, 0.0));
+  EXPECT_THROW(S21Matrix::FromCSV(path), std::runtime_error);
+  EXPECT_THROW(S21Matrix::FromCSV(path, ',', S21FileMode::kRead),
+               std::runtime_error);
+}
+
 TEST(S21MatrixTest, OperatorAssign) {
   S21Matrix matrix1(2, 2);
   matrix1.SetElement(0, 0, 1.0);